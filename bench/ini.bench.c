@@ -0,0 +1,591 @@
+/*******************************************************************************
+ *  @file      ini.bench.c
+ *  @brief     Parser and lookup benchmark over synthetic corpora
+ *  @author    Young Sideways
+ *  @date      17.10.2026
+ *  @copyright © Young Sideways, 2026. All right reserved.
+ *
+ *  Every corpus of the matrix (sizes x depths x keys x comments x values) is
+ *  generated to a file, loaded by every loader, queried and walked. One JSON object
+ *  per line is printed for every case, progress goes to stderr:
+ *
+ *      ini-bench --sizes 1K,1M,1G --depth 0,4 --values mixed,string --out results.jsonl
+ ******************************************************************************/
+
+#include "ini.corpus.h"
+
+#pragma region --- INCLUDES ---
+
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
+
+#include "ini/ini.h"
+#include "ini/ini.parser.h"
+
+#ifdef _WIN32
+#   define WIN32_LEAN_AND_MEAN
+#   define PSAPI_VERSION 2
+#   include <windows.h>
+#   include <psapi.h>
+#else
+#   include <time.h>
+#   include <sys/resource.h>
+#endif
+
+#pragma endregion
+
+#pragma region --- MACROS ---
+
+#define BENCH_MAX_VALUES   16U           //!< max items of a list option
+#define BENCH_PATH_SIZE    1024U         //!< max path of a corpus file
+#define BENCH_CASE_TIME    2000000000ULL //!< ns, runs of a case stop after it
+#define BENCH_LOOKUP_TIME  250000000ULL  //!< ns spent in every lookup case
+#define BENCH_PUSH_SIZE    (64U << 10)   //!< fragment of the push parser case
+#define BENCH_BATCH_SIZE   32U           //!< queries of an ini_get_values call
+#define BENCH_WRITE_BUFFER (1U << 20)    //!< stdio buffer of the corpus file
+
+#pragma endregion
+
+#pragma region --- TYPEDEFS ---
+
+/**
+ *  @brief counting memory hooks
+ */
+typedef struct bench_counter {
+    uint64_t allocs; //!< count of alloc calls
+    uint64_t bytes;  //!< total allocated bytes
+    uint64_t live;   //!< not freed bytes
+    uint64_t peak;   //!< max of live
+} bench_counter;
+
+/**
+ *  @brief corpus under test
+ */
+typedef struct bench_input {
+    const char* path;      //!< corpus file
+    char* buffer;          //!< text for the in-memory cases, read again before every run
+    size_t size;           //!< text size
+    unsigned threads;      //!< threads of the parallel loader
+    bench_counter counter; //!< allocations of the last run (cases with an allocator)
+} bench_input;
+
+/**
+ *  @brief  loader case
+ *  @retval - ns of the timed part, 0 on fail
+ */
+typedef uint64_t (*bench_run)(bench_input* input);
+
+typedef struct bench_case {
+    const char* name;  //!< name in the results
+    bench_run run;     //!< timed body
+    bool in_memory;    //!< input->buffer is refilled before the run
+    bool counted;      //!< input->counter is filled by the run
+} bench_case;
+
+/**
+ *  @brief list option
+ */
+typedef struct bench_list {
+    uint64_t items[BENCH_MAX_VALUES];
+    size_t count;
+} bench_list;
+
+typedef struct bench_options {
+    bench_list sizes;
+    bench_list depths;
+    bench_list keys;
+    bench_list comments;
+    bench_list values;
+    uint64_t seed;
+    unsigned repeat;   //!< max runs of a loader case
+    unsigned threads;  //!< threads of the parallel loader, 0 - all
+    const char* dir;   //!< directory of the corpus files
+    bool keep;         //!< corpus files aren't removed
+    FILE* out;         //!< results
+} bench_options;
+
+#pragma endregion
+
+#pragma region --- INTERNAL ---
+
+static uint64_t _now(void) {
+#ifdef _WIN32
+    LARGE_INTEGER counter, frequency;
+    QueryPerformanceCounter(&counter);
+    QueryPerformanceFrequency(&frequency);
+    return (uint64_t)((double)counter.QuadPart * 1e9 / (double)frequency.QuadPart);
+#else
+    struct timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return (uint64_t)time.tv_sec * 1000000000ULL + (uint64_t)time.tv_nsec;
+#endif
+}
+
+/**
+ *  @brief  resets peak resident set of the process
+ *  @retval - false if only the peak of the whole run is known
+ */
+static bool _peak_reset(void) {
+#ifdef __linux__
+    FILE* refs = fopen("/proc/self/clear_refs", "w");
+    if (!refs)
+        return false;
+    bool reset = fputs("5", refs) >= 0;
+    return (fclose(refs) == 0) && reset;
+#else
+    return false;
+#endif
+}
+
+/**
+ *  @brief peak resident set in KiB
+ */
+static uint64_t _peak_rss(void) {
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS counters;
+    if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+        return 0U;
+    return (uint64_t)counters.PeakWorkingSetSize >> 10;
+#else
+#   ifdef __linux__
+    FILE* status = fopen("/proc/self/status", "r");
+    if (status) {
+        char line[256];
+        uint64_t peak = 0U;
+        while (fgets(line, sizeof(line), status))
+            if (sscanf(line, "VmHWM: %" SCNu64, &peak) == 1)
+                break;
+        fclose(status);
+        if (peak)
+            return peak;
+    }
+#   endif
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0)
+        return 0U;
+#   ifdef __APPLE__
+    return (uint64_t)usage.ru_maxrss >> 10;
+#   else
+    return (uint64_t)usage.ru_maxrss;
+#   endif
+#endif
+}
+
+static void* _counted_alloc(size_t size, void* user) {
+    bench_counter* counter = user;
+    void* block = malloc(size);
+    if (block) {
+        counter->allocs++;
+        counter->bytes += size;
+        counter->live  += size;
+        if (counter->live > counter->peak)
+            counter->peak = counter->live;
+    }
+    return block;
+}
+
+static void _counted_free(void* block, size_t size, void* user) {
+    bench_counter* counter = user;
+    counter->live -= size;
+    free(block);
+}
+
+static ini_allocator _counted(bench_input* input) {
+    memset(&input->counter, 0, sizeof(bench_counter));
+    return (ini_allocator){ .alloc = _counted_alloc, .free = _counted_free, .user = &input->counter };
+}
+
+/**
+ *  @brief  reads the corpus to the buffer, the in-memory cases unescape it in place
+ */
+static bool _read_input(bench_input* input) {
+    FILE* stream = fopen(input->path, "rb");
+    if (!stream)
+        return false;
+    size_t readed = fread(input->buffer, 1U, input->size, stream);
+    fclose(stream);
+    return readed == input->size;
+}
+
+static uint64_t _elapsed(uint64_t start, INI* file) {
+    uint64_t time = _now() - start;
+    if (!file)
+        return 0U;
+    ini_destroy(file);
+    return time ? time : 1U;
+}
+
+static uint64_t _run_stream(bench_input* input) {
+    uint64_t start = _now();
+    return _elapsed(start, ini_open(input->path));
+}
+
+static uint64_t _run_mapped(bench_input* input) {
+    uint64_t start = _now();
+    return _elapsed(start, ini_open_mapped(input->path));
+}
+
+static uint64_t _run_lazy(bench_input* input) {
+    uint64_t start = _now();
+    return _elapsed(start, ini_open_lazy(input->path));
+}
+
+static uint64_t _run_parallel(bench_input* input) {
+    uint64_t start = _now();
+    return _elapsed(start, ini_open_parallel(input->path, input->threads));
+}
+
+static uint64_t _run_buffer(bench_input* input) {
+    ini_allocator allocator = _counted(input);
+    uint64_t start = _now();
+    INI* file = ini_create(&allocator);
+    if (file)
+        ini_tokenize_buffer(file, input->buffer, input->size, false);
+    return _elapsed(start, file);
+}
+
+static uint64_t _run_push(bench_input* input) {
+    ini_allocator allocator = _counted(input);
+    uint64_t start = _now();
+    ini_parser* parser = ini_parser_create(&allocator);
+    for (size_t offset = 0U; parser && offset < input->size; offset += BENCH_PUSH_SIZE) {
+        size_t size = input->size - offset < BENCH_PUSH_SIZE ? input->size - offset : BENCH_PUSH_SIZE;
+        if (!ini_parser_feed(parser, input->buffer + offset, size))
+            break;
+    }
+    return _elapsed(start, ini_parser_finish(parser));
+}
+
+static bool _count_property(const ini_string* key, const ini_string* value, void* user) {
+    (void)key;
+    (void)value;
+    (*(uint64_t*)user)++;
+    return true;
+}
+
+static uint64_t _run_sax(bench_input* input) {
+    static const ini_callbacks callbacks = { .on_section = NULL, .on_property = _count_property, .on_error = NULL };
+    uint64_t properties = 0U;
+    uint64_t start = _now();
+    ini_parse_buffer(input->buffer, input->size, &callbacks, &properties);
+    uint64_t time = _now() - start;
+    return properties ? (time ? time : 1U) : 0U;
+}
+
+static const bench_case cases[] = {
+    { "stream",   _run_stream,   false, false },
+    { "mapped",   _run_mapped,   false, false },
+    { "lazy",     _run_lazy,     false, false },
+    { "parallel", _run_parallel, false, false },
+    { "buffer",   _run_buffer,   true,  true  },
+    { "push",     _run_push,     true,  true  },
+    { "sax",      _run_sax,      true,  false },
+};
+
+static void _record_corpus(const bench_options* options, const char* name, const ini_corpus* corpus, const char* label) {
+    fprintf(options->out, "{\"corpus\":\"%s\",\"bytes\":%" PRIu64 ",\"sections\":%" PRIu64 ",\"properties\":%" PRIu64
+            ",\"comments\":%" PRIu64 ",\"case\":\"%s\"", name, corpus->size, corpus->sections, corpus->properties,
+            corpus->comments, label);
+}
+
+static bool _bench_case(const bench_options* options, const char* name, const ini_corpus* corpus,
+                        bench_input* input, const bench_case* item) {
+    bool reset = _peak_reset();
+    uint64_t best = UINT64_MAX, total = 0U;
+    unsigned runs = 0U;
+    while (runs < options->repeat && (!runs || total < BENCH_CASE_TIME)) {
+        if (item->in_memory && !_read_input(input))
+            return false;
+        uint64_t time = item->run(input);
+        if (!time)
+            return false;
+        best = time < best ? time : best;
+        total += time;
+        runs++;
+    }
+
+    _record_corpus(options, name, corpus, item->name);
+    fprintf(options->out, ",\"runs\":%u,\"best_s\":%.6f,\"mean_s\":%.6f,\"mb_s\":%.2f,\"peak_rss_kb\":%" PRIu64 ",\"rss_reset\":%s",
+            runs, best / 1e9, total / 1e9 / runs, (double)corpus->size / (1 << 20) / (best / 1e9), _peak_rss(), reset ? "true" : "false");
+    if (item->counted)
+        fprintf(options->out, ",\"allocs\":%" PRIu64 ",\"alloc_bytes\":%" PRIu64 ",\"alloc_peak\":%" PRIu64 ",\"allocs_per_key\":%.6f",
+                input->counter.allocs, input->counter.bytes, input->counter.peak,
+                corpus->properties ? (double)input->counter.allocs / (double)corpus->properties : 0.0);
+    fputs("}\n", options->out);
+    fflush(options->out);
+    return true;
+}
+
+/**
+ *  @brief lookups of sampled properties by names, by handles, of missing keys and in batches, then by names in a frozen file
+ */
+static bool _bench_lookups(const bench_options* options, const char* name, const ini_corpus* corpus, const char* path) {
+    INI* file = ini_open(path);
+    if (!file || !corpus->sample_count)
+        return false;
+
+    ini_key_handle* handles = malloc(corpus->sample_count * 2U * sizeof(ini_key_handle));
+    ini_query* queries = malloc(corpus->sample_count * sizeof(ini_query));
+    if (!handles || !queries) {
+        free(handles);
+        free(queries);
+        ini_destroy(file);
+        return false;
+    }
+    for (size_t i = 0; i < corpus->sample_count; i++) {
+        handles[2U * i]      = ini_intern(file, corpus->samples[i].key);
+        handles[2U * i + 1U] = strcmp(corpus->samples[i].section, "root") ? ini_intern(file, corpus->samples[i].section) : 0U;
+        queries[i] = (ini_query){ .section = corpus->samples[i].section, .key = corpus->samples[i].key };
+    }
+
+    static const char* const labels[] = { "get_value", "get_value_handle", "get_value_miss", "get_values",
+                                          "get_value_frozen", "get_value_miss_frozen", "get_values_frozen" };
+    static const unsigned lookups[] = { 0U, 1U, 2U, 3U, 0U, 2U, 3U };
+    for (unsigned kind = 0U; kind < sizeof(labels) / sizeof(*labels); kind++) {
+        if (kind == 4U && !ini_freeze(file))
+            break;
+        unsigned lookup = lookups[kind];
+        uint64_t ops = 0U, found = 0U, time = 0U;
+        uint64_t start = _now();
+        while (time < BENCH_LOOKUP_TIME) {
+            for (size_t i = 0; i < corpus->sample_count; ) {
+                if (lookup == 3U) {
+                    ini_value values[BENCH_BATCH_SIZE];
+                    size_t count = corpus->sample_count - i < BENCH_BATCH_SIZE ? corpus->sample_count - i : BENCH_BATCH_SIZE;
+                    found += ini_get_values(file, queries + i, count, values);
+                    i += count;
+                    continue;
+                }
+                const ini_corpus_sample* sample = &corpus->samples[i];
+                ini_value value = (lookup == 0U) ? ini_get_value(file, sample->key, sample->section)
+                                : (lookup == 1U) ? ini_get_value_handle(file, handles[2U * i], handles[2U * i + 1U])
+                                                 : ini_get_value(file, "missing_key", sample->section);
+                found += value.type != INI_NONE;
+                i++;
+            }
+            ops += corpus->sample_count;
+            time = _now() - start;
+        }
+        _record_corpus(options, name, corpus, labels[kind]);
+        fprintf(options->out, ",\"ops\":%" PRIu64 ",\"found\":%" PRIu64 ",\"ns_op\":%.2f}\n", ops, found, (double)time / (double)ops);
+    }
+    fflush(options->out);
+
+    free(queries);
+    free(handles);
+    ini_destroy(file);
+    return true;
+}
+
+/**
+ *  @brief full document walks: section by section, and over every property of the file at once
+ */
+static bool _bench_scans(const bench_options* options, const char* name, const ini_corpus* corpus, const char* path) {
+    INI* file = ini_open(path);
+    if (!file)
+        return false;
+
+    static const char* const labels[] = { "scan_sections", "scan_file" };
+    for (unsigned kind = 0U; kind < 2U; kind++) {
+        uint64_t ops = 0U, found = 0U, time = 0U;
+        uint64_t start = _now();
+        while (time < BENCH_LOOKUP_TIME) {
+            ini_property_walk properties;
+            if (kind == 0U) {
+                ini_section_walk sections;
+                ini_section_walk_init(&sections, file);
+                for (const ini_section* section; (section = ini_section_walk_next(&sections)); ) {
+                    ini_property_walk_init(&properties, file, section);
+                    for (const ini_property* property; (property = ini_property_walk_next(&properties)); ops++)
+                        found += property->value.type != INI_NONE;
+                }
+            }
+            else {
+                ini_property_walk_init(&properties, file, NULL);
+                for (const ini_property* property; (property = ini_property_walk_next(&properties)); ops++)
+                    found += property->value.type != INI_NONE;
+            }
+            time = _now() - start;
+        }
+        _record_corpus(options, name, corpus, labels[kind]);
+        fprintf(options->out, ",\"ops\":%" PRIu64 ",\"found\":%" PRIu64 ",\"ns_op\":%.2f}\n", ops, found, ops ? (double)time / (double)ops : 0.0);
+    }
+    fflush(options->out);
+
+    ini_destroy(file);
+    return true;
+}
+
+static bool _bench_corpus(const bench_options* options, const ini_corpus_config* config, ini_corpus* corpus) {
+    char name[INI_CORPUS_NAME_SIZE];
+    char path[BENCH_PATH_SIZE];
+    ini_corpus_name(config, name, sizeof(name));
+    snprintf(path, sizeof(path), "%s/%s.ini", options->dir, name);
+
+    fprintf(stderr, "%s: generating\n", name);
+    FILE* stream = fopen(path, "wb");
+    if (!stream) {
+        fprintf(stderr, "%s: can't create %s\n", name, path);
+        return false;
+    }
+    setvbuf(stream, NULL, _IOFBF, BENCH_WRITE_BUFFER);
+    bool written = ini_corpus_write(config, stream, corpus);
+    if (fclose(stream) != 0 || !written) {
+        fprintf(stderr, "%s: can't write %s\n", name, path);
+        remove(path);
+        return false;
+    }
+
+    bench_input input = { .path = path, .buffer = malloc((size_t)corpus->size + 1U), .size = (size_t)corpus->size,
+                          .threads = options->threads };
+    bool passed = input.buffer != NULL;
+    for (size_t i = 0; passed && i < sizeof(cases) / sizeof(*cases); i++) {
+        fprintf(stderr, "%s: %s\n", name, cases[i].name);
+        if (!(passed = _bench_case(options, name, corpus, &input, &cases[i])))
+            fprintf(stderr, "%s: %s failed\n", name, cases[i].name);
+    }
+    free(input.buffer);
+
+    if (passed) {
+        fprintf(stderr, "%s: lookups\n", name);
+        if (!(passed = _bench_lookups(options, name, corpus, path)))
+            fprintf(stderr, "%s: lookups failed\n", name);
+    }
+    if (passed) {
+        fprintf(stderr, "%s: scans\n", name);
+        if (!(passed = _bench_scans(options, name, corpus, path)))
+            fprintf(stderr, "%s: scans failed\n", name);
+    }
+    if (!options->keep)
+        remove(path);
+    return passed;
+}
+
+/**
+ *  @brief  parses "1K,64K,1M" (K, M and G are powers of 1024)
+ */
+static bool _parse_sizes(const char* text, bench_list* list) {
+    list->count = 0U;
+    while (*text && list->count < BENCH_MAX_VALUES) {
+        char* end;
+        uint64_t value = strtoull(text, &end, 10);
+        switch (*end)
+        {
+        case 'G': case 'g': value <<= 10; /* fallthrough */
+        case 'M': case 'm': value <<= 10; /* fallthrough */
+        case 'K': case 'k': value <<= 10; end++; break;
+        default: break;
+        }
+        if (end == text || (*end && *end != ','))
+            return false;
+        list->items[list->count++] = value;
+        text = *end ? end + 1 : end;
+    }
+    return list->count && !*text;
+}
+
+static bool _parse_values(const char* text, bench_list* list) {
+    static const char* const kinds[] = { "mixed", "int", "double", "string" };
+    list->count = 0U;
+    while (*text && list->count < BENCH_MAX_VALUES) {
+        size_t length = strcspn(text, ",");
+        uint64_t kind = 0U;
+        while (kind < 4U && (strlen(kinds[kind]) != length || strncmp(kinds[kind], text, length)))
+            kind++;
+        if (kind == 4U)
+            return false;
+        list->items[list->count++] = kind;
+        text += length + (text[length] == ',');
+    }
+    return list->count && !*text;
+}
+
+static void _usage(void) {
+    fputs("usage: ini-bench [options]\n"
+          "  --sizes LIST     corpus sizes, K/M/G suffixes (1K,64K,1M,16M)\n"
+          "  --depth LIST     max subsection depths (2)\n"
+          "  --keys LIST      max properties of a section (8)\n"
+          "  --comments LIST  percents of comment lines (10)\n"
+          "  --values LIST    mixed, int, double, string (mixed)\n"
+          "  --seed N         generator seed (1)\n"
+          "  --repeat N       max runs of a loader case (5)\n"
+          "  --threads N      threads of the parallel loader, 0 - all (0)\n"
+          "  --dir PATH       directory of the corpus files (.)\n"
+          "  --keep           keep the corpus files\n"
+          "  --out PATH       results, one JSON object per line (stdout)\n", stderr);
+}
+
+static bool _parse_options(int argc, char** argv, bench_options* options) {
+    *options = (bench_options){ .sizes = { { 1U << 10, 64U << 10, 1U << 20, 16U << 20 }, 4U }, .depths = { { 2U }, 1U },
+                                .keys = { { 8U }, 1U }, .comments = { { 10U }, 1U }, .values = { { INI_CORPUS_MIXED }, 1U },
+                                .seed = 1U, .repeat = 5U, .threads = 0U, .dir = ".", .keep = false, .out = stdout };
+    for (int i = 1; i < argc; i++) {
+        const char* option = argv[i];
+        if (!strcmp(option, "--keep")) {
+            options->keep = true;
+            continue;
+        }
+        if (i + 1 >= argc)
+            return false;
+        const char* value = argv[++i];
+        bool parsed = true;
+        if (!strcmp(option, "--sizes"))
+            parsed = _parse_sizes(value, &options->sizes);
+        else if (!strcmp(option, "--depth"))
+            parsed = _parse_sizes(value, &options->depths);
+        else if (!strcmp(option, "--keys"))
+            parsed = _parse_sizes(value, &options->keys);
+        else if (!strcmp(option, "--comments"))
+            parsed = _parse_sizes(value, &options->comments);
+        else if (!strcmp(option, "--values"))
+            parsed = _parse_values(value, &options->values);
+        else if (!strcmp(option, "--seed"))
+            options->seed = strtoull(value, NULL, 10);
+        else if (!strcmp(option, "--repeat"))
+            parsed = (options->repeat = (unsigned)strtoul(value, NULL, 10)) > 0U;
+        else if (!strcmp(option, "--threads"))
+            options->threads = (unsigned)strtoul(value, NULL, 10);
+        else if (!strcmp(option, "--dir"))
+            options->dir = value;
+        else if (!strcmp(option, "--out"))
+            parsed = (options->out = fopen(value, "w")) != NULL;
+        else
+            parsed = false;
+        if (!parsed)
+            return false;
+    }
+    return true;
+}
+
+#pragma endregion
+
+int main(int argc, char** argv) {
+    bench_options options;
+    if (!_parse_options(argc, argv, &options)) {
+        _usage();
+        return EXIT_FAILURE;
+    }
+
+    // samples of the biggest corpus don't fit the stack
+    ini_corpus* corpus = malloc(sizeof(ini_corpus));
+    if (!corpus)
+        return EXIT_FAILURE;
+
+    bool passed = true;
+    for (size_t s = 0; s < options.sizes.count; s++)
+        for (size_t d = 0; d < options.depths.count; d++)
+            for (size_t k = 0; k < options.keys.count; k++)
+                for (size_t c = 0; c < options.comments.count; c++)
+                    for (size_t v = 0; v < options.values.count; v++) {
+                        ini_corpus_config config = { .size = options.sizes.items[s], .depth = (unsigned)options.depths.items[d],
+                                                     .keys = (unsigned)options.keys.items[k], .comments = (unsigned)options.comments.items[c],
+                                                     .values = (ini_corpus_values)options.values.items[v], .seed = options.seed };
+                        passed &= _bench_corpus(&options, &config, corpus);
+                    }
+
+    free(corpus);
+    if (options.out != stdout)
+        fclose(options.out);
+    return passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,191 @@
+/*******************************************************************************
+ *  @file      ini.corpus.c
+ *  @brief     Synthetic ini texts for the benchmark
+ *  @author    Young Sideways
+ *  @date      17.10.2026
+ *  @copyright © Young Sideways, 2026. All right reserved.
+ ******************************************************************************/
+
+#include "ini.corpus.h"
+
+#pragma region --- INCLUDES ---
+
+#include <string.h>
+#include <inttypes.h>
+
+#pragma endregion
+
+#pragma region --- MACROS ---
+
+#define INI_CORPUS_MAX_DEPTH 15U //!< deeper configs are clamped (see INI_MAX_DEPTH)
+#define INI_CORPUS_LINE_SIZE 256U //!< longest generated line
+
+#pragma endregion
+
+#pragma region --- INTERNAL ---
+
+/**
+ *  @brief generator state
+ */
+typedef struct ini_corpus_writer {
+    const ini_corpus_config* config;
+    FILE* stream;
+    ini_corpus* corpus;
+    uint64_t random;                                       //!< xorshift state
+    char path[INI_CORPUS_MAX_DEPTH + 1][INI_CORPUS_NAME_SIZE]; //!< full names of the current sections by depth
+    bool failed;
+} ini_corpus_writer;
+
+static const char* const words[] = {
+    "alpha", "bravo", "charlie", "delta", "echo", "foxtrot", "golf", "hotel",
+    "india", "juliett", "kilo", "lima", "mike", "november", "oscar", "papa"
+};
+
+static uint64_t _random(ini_corpus_writer* writer) {
+    uint64_t x = writer->random;
+    x ^= x >> 12;
+    x ^= x << 25;
+    x ^= x >> 27;
+    writer->random = x;
+    return x * 0x2545F4914F6CDD1DULL;
+}
+
+static unsigned _below(ini_corpus_writer* writer, unsigned bound) {
+    return (unsigned)(_random(writer) % bound);
+}
+
+static void _line(ini_corpus_writer* writer, const char* line, int size) {
+    if (size < 0 || fwrite(line, 1U, (size_t)size, writer->stream) != (size_t)size)
+        writer->failed = true;
+    else
+        writer->corpus->size += (uint64_t)size;
+}
+
+/**
+ *  @brief keeps property with the probability of reservoir sampling
+ */
+static void _sample(ini_corpus_writer* writer, unsigned depth, const char* key) {
+    ini_corpus* corpus = writer->corpus;
+    uint64_t slot = corpus->sample_count < INI_CORPUS_SAMPLE_COUNT ? corpus->sample_count : _random(writer) % corpus->properties;
+    if (slot >= INI_CORPUS_SAMPLE_COUNT)
+        return;
+    if (slot == corpus->sample_count)
+        corpus->sample_count++;
+    memcpy(corpus->samples[slot].section, writer->path[depth], INI_CORPUS_NAME_SIZE);
+    memcpy(corpus->samples[slot].key, key, INI_CORPUS_NAME_SIZE);
+}
+
+static int _value(ini_corpus_writer* writer, char* buffer, size_t size) {
+    ini_corpus_values kind = writer->config->values;
+    if (kind == INI_CORPUS_MIXED)
+        kind = (ini_corpus_values)(1U + _below(writer, 3U));
+
+    switch (kind)
+    {
+    case INI_CORPUS_INT:
+        if (!_below(writer, 16U))
+            return snprintf(buffer, size, "%" PRId64, (int64_t)(_random(writer) >> 2) - (INT64_MAX >> 2));
+        return snprintf(buffer, size, "%d", (int)_below(writer, 200000U) - 100000);
+    case INI_CORPUS_DOUBLE:
+        if (!_below(writer, 8U))
+            return snprintf(buffer, size, "%u.%ue%d", _below(writer, 10U), _below(writer, 1000U), (int)_below(writer, 40U) - 20);
+        return snprintf(buffer, size, "%d.%03u", (int)_below(writer, 2000U) - 1000, _below(writer, 1000U));
+    default: {
+        int length = 0;
+        unsigned count = 1U + _below(writer, 5U);
+        for (unsigned i = 0; i < count && length >= 0 && (size_t)length < size; i++)
+            length += snprintf(buffer + length, size - (size_t)length, "%s%s%s", i ? " " : "",
+                               words[_below(writer, sizeof(words) / sizeof(*words))], _below(writer, 16U) ? "" : "\\;");
+        return length;
+    }
+    }
+}
+
+static void _comment(ini_corpus_writer* writer) {
+    char line[INI_CORPUS_LINE_SIZE];
+    if (_below(writer, 100U) >= writer->config->comments)
+        return;
+    int size = snprintf(line, sizeof(line), "%c %s %s %s\n", _below(writer, 2U) ? ';' : '#',
+                        words[_below(writer, 16U)], words[_below(writer, 16U)], words[_below(writer, 16U)]);
+    _line(writer, line, size);
+    writer->corpus->comments++;
+}
+
+static void _properties(ini_corpus_writer* writer, unsigned depth) {
+    char line[INI_CORPUS_LINE_SIZE];
+    char key[INI_CORPUS_NAME_SIZE];
+    unsigned count = 1U + _below(writer, writer->config->keys ? writer->config->keys : 1U);
+    for (unsigned i = 0; i < count && !writer->failed; i++) {
+        _comment(writer);
+        snprintf(key, sizeof(key), "key%u", i);
+        int size = snprintf(line, sizeof(line), "%s = ", key);
+        size += _value(writer, line + size, sizeof(line) - 1U - (size_t)size);
+        line[size++] = '\n';
+        _line(writer, line, size);
+        writer->corpus->properties++;
+        _sample(writer, depth, key);
+    }
+}
+
+#pragma endregion
+
+#pragma region --- FUNCTIONS ---
+
+bool ini_corpus_write(const ini_corpus_config* config, FILE* stream, ini_corpus* corpus) {
+    memset(corpus, 0, sizeof(ini_corpus));
+    ini_corpus_writer writer = { .config = config, .stream = stream, .corpus = corpus,
+                                 .random = config->seed ? config->seed : 0x9E3779B97F4A7C15ULL, .failed = false };
+    unsigned max_depth = config->depth < INI_CORPUS_MAX_DEPTH ? config->depth : INI_CORPUS_MAX_DEPTH;
+
+    // a few properties of the root section go first
+    memcpy(writer.path[0], "root", sizeof("root"));
+    _properties(&writer, 0U);
+
+    char line[INI_CORPUS_LINE_SIZE];
+    unsigned depth = 0U;
+    while (corpus->size < config->size && !writer.failed) {
+        // a subsection may only go one level deeper than the previous section
+        unsigned next = _below(&writer, (depth < max_depth ? depth + 1U : max_depth) + 1U);
+        char name[INI_CORPUS_NAME_SIZE];
+        size_t name_length = (size_t)snprintf(name, sizeof(name), "sub%" PRIu64, corpus->sections);
+        size_t parent_length = next ? strlen(writer.path[next - 1U]) : 0U;
+        // a full name, that doesn't fit a sample, starts a new top level section
+        if (next && parent_length + name_length + 2U > INI_CORPUS_NAME_SIZE)
+            next = 0U;
+
+        int size;
+        if (!next || !corpus->sections) {
+            next = 0U;
+            snprintf(writer.path[0], INI_CORPUS_NAME_SIZE, "sec%" PRIu64, corpus->sections);
+            size = snprintf(line, sizeof(line), "%s[%s]\n", corpus->sections ? "\n" : "", writer.path[0]);
+        }
+        else {
+            char* path = writer.path[next];
+            memcpy(path, writer.path[next - 1U], parent_length);
+            path[parent_length] = '.';
+            memcpy(path + parent_length + 1U, name, name_length + 1U);
+            size = snprintf(line, sizeof(line), "[%.*s%s]\n", (int)next, "...............", name);
+        }
+        _line(&writer, line, size);
+        corpus->sections++;
+        depth = next;
+        _properties(&writer, depth);
+    }
+    return !writer.failed;
+}
+
+void ini_corpus_name(const ini_corpus_config* config, char* buffer, size_t size) {
+    static const char* const kinds[] = { "mixed", "int", "double", "string" };
+    static const char units[] = { 'B', 'K', 'M', 'G' };
+
+    uint64_t amount = config->size;
+    unsigned unit = 0U;
+    while (unit < 3U && amount >= 1024U && !(amount % 1024U)) {
+        amount /= 1024U;
+        unit++;
+    }
+    snprintf(buffer, size, "%" PRIu64 "%c-d%u-k%u-c%u-%s", amount, units[unit], config->depth,
+             config->keys, config->comments, kinds[config->values & 3U]);
+}
+
+#pragma endregion
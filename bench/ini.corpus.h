@@ -0,0 +1,108 @@
+/*******************************************************************************
+ *  @file      ini.corpus.h
+ *  @brief     Synthetic ini texts for the benchmark
+ *  @author    Young Sideways
+ *  @date      17.10.2026
+ *  @copyright © Young Sideways, 2026. All right reserved.
+ ******************************************************************************/
+
+#ifndef _INI_CORPUS_H_
+#define _INI_CORPUS_H_
+
+#pragma once
+
+#pragma region --- INCLUDES ---
+
+#include <stdio.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#pragma endregion
+
+#pragma region --- MACROS ---
+
+#define INI_CORPUS_NAME_SIZE    64U   //!< max length of a dotted section name or a key of a sample
+#define INI_CORPUS_SAMPLE_COUNT 4096U //!< properties kept for the lookup benchmark
+
+#pragma endregion
+
+#pragma region --- TYPEDEFS ---
+
+typedef enum ini_corpus_values ini_corpus_values;
+
+typedef struct ini_corpus_config ini_corpus_config;
+typedef struct ini_corpus_sample ini_corpus_sample;
+typedef struct ini_corpus        ini_corpus;
+
+#pragma endregion
+
+#pragma region --- ENUMS ---
+
+enum ini_corpus_values {
+    INI_CORPUS_MIXED  = 0x0U, //!< every kind below in equal parts
+    INI_CORPUS_INT    = 0x1U, //!< integers, some of them out of int range
+    INI_CORPUS_DOUBLE = 0x2U, //!< decimals with fractions and exponents
+    INI_CORPUS_STRING = 0x3U  //!< words with spaces and escaped characters
+};
+
+#pragma endregion
+
+#pragma region --- STRUCTS ---
+
+/**
+ *  @brief shape of a generated text
+ */
+struct ini_corpus_config {
+    uint64_t size;            //!< text size in bytes, the last section is completed, so the text is a bit longer
+    unsigned depth;           //!< max subsection depth, 0 - top level sections only
+    unsigned keys;            //!< max properties of a section, the count of every section is random in [1, keys]
+    unsigned comments;        //!< percent of comment lines
+    ini_corpus_values values; //!< kind of values
+    uint64_t seed;            //!< the same seed and config give the same text
+};
+
+/**
+ *  @brief property of the text
+ */
+struct ini_corpus_sample {
+    char section[INI_CORPUS_NAME_SIZE]; //!< full dotted section name
+    char key[INI_CORPUS_NAME_SIZE];     //!< property key
+};
+
+/**
+ *  @brief written text with its counters
+ */
+struct ini_corpus {
+    uint64_t size;                                        //!< bytes written
+    uint64_t sections;                                    //!< declared sections
+    uint64_t properties;                                  //!< properties
+    uint64_t comments;                                    //!< comment lines
+    size_t sample_count;                                  //!< filled samples
+    ini_corpus_sample samples[INI_CORPUS_SAMPLE_COUNT];   //!< properties picked evenly over the text
+};
+
+#pragma endregion
+
+#pragma region --- FUNCTIONS ---
+
+/**
+ *  @brief  writes text to the stream, nothing but a line is kept in memory
+ *  @param  config - shape of the text
+ *  @param  stream - binary output stream
+ *  @param  corpus - counters and samples of the written text
+ *  @retval        - false on write fail
+ */
+bool ini_corpus_write(const ini_corpus_config* config, FILE* stream, ini_corpus* corpus);
+
+/**
+ *  @brief  short name of the config ("1M-d2-k8-c10-mixed") for the results
+ *  @param  config - shape of the text
+ *  @param  buffer - output
+ *  @param  size   - output size
+ */
+void ini_corpus_name(const ini_corpus_config* config, char* buffer, size_t size);
+
+#pragma endregion
+
+#endif // !_INI_CORPUS_H_
@@ -0,0 +1,152 @@
+/*******************************************************************************
+ *  @file      ini.arena.c
+ *  @brief     Bump allocator owning the whole ini object graph
+ *  @author    Young Sideways
+ *  @date      17.10.2026
+ *  @copyright © Young Sideways, 2026. All right reserved.
+ ******************************************************************************/
+
+#include "ini.arena.h"
+
+#pragma region --- INCLUDES ---
+
+#include <stdlib.h>
+#include <string.h>
+
+#pragma endregion
+
+#pragma region --- MACROS ---
+
+#define ALIGN_UP(value, align) (((value) + ((align) - 1U)) & ~(uintptr_t)((align) - 1U))
+
+#pragma endregion
+
+#pragma region --- STRUCTS ---
+
+struct ini_arena_block {
+    ini_arena_block* prev; //!< previous (full) block
+    size_t size;           //!< usable size of data
+    size_t used;           //!< bytes already given away
+    uint8_t* data;         //!< first usable byte (right after the header)
+};
+
+#pragma endregion
+
+#pragma region --- INTERNAL ---
+
+static void* _default_alloc(size_t size, void* user) {
+    (void)user;
+    return malloc(size);
+}
+
+static void _default_free(void* block, size_t size, void* user) {
+    (void)size;
+    (void)user;
+    free(block);
+}
+
+static ini_arena_block* _block_new(ini_arena* arena, size_t block_size) {
+    ini_arena_block* block = arena->allocator.alloc(sizeof(ini_arena_block) + block_size, arena->allocator.user);
+    if (!block)
+        return NULL;
+
+    block->prev = arena->head;
+    block->size = block_size;
+    block->used = 0U;
+    block->data = (uint8_t*)(block + 1);
+    arena->head = block;
+    return block;
+}
+
+static ini_arena_block* _block_push(ini_arena* arena, size_t size) {
+    size_t block_size = arena->next_size;
+    while (block_size < size + INI_ARENA_ALIGNMENT && block_size < SIZE_MAX / 2U)
+        block_size <<= 1;
+
+    ini_arena_block* block = _block_new(arena, block_size);
+    if (block && arena->next_size < INI_ARENA_MAX_BLOCK_SIZE)
+        arena->next_size <<= 1;
+    return block;
+}
+
+#pragma endregion
+
+#pragma region --- FUNCTIONS ---
+
+const ini_allocator ini_default_allocator = { .alloc = _default_alloc, .free = _default_free, .user = NULL };
+
+void ini_arena_init(ini_arena* arena, const ini_allocator* allocator) {
+    arena->allocator = allocator ? *allocator : ini_default_allocator;
+    arena->head      = NULL;
+    arena->next_size = INI_ARENA_MIN_BLOCK_SIZE;
+}
+
+void* ini_arena_alloc(ini_arena* arena, size_t size) {
+    ini_arena_block* block = arena->head;
+    if (block) {
+        uintptr_t first  = ALIGN_UP((uintptr_t)(block->data + block->used), INI_ARENA_ALIGNMENT);
+        size_t    offset = (size_t)(first - (uintptr_t)block->data);
+        if (offset <= block->size && block->size - offset >= size) {
+            block->used = offset + size;
+            return (void*)first;
+        }
+    }
+    if (!(block = _block_push(arena, size)))
+        return NULL;
+
+    uintptr_t first = ALIGN_UP((uintptr_t)block->data, INI_ARENA_ALIGNMENT);
+    block->used = (size_t)(first - (uintptr_t)block->data) + size;
+    return (void*)first;
+}
+
+char* ini_arena_strdup(ini_arena* arena, const char* str, size_t size) {
+    ini_arena_block* block = arena->head;
+    if (!block || block->size - block->used < size + 1U)
+        if (!(block = _block_push(arena, size + 1U)))
+            return NULL;
+
+    char* copy = (char*)(block->data + block->used);
+    block->used += size + 1U;
+    memcpy(copy, str, size);
+    copy[size] = '\0';
+    return copy;
+}
+
+bool ini_arena_reserve(ini_arena* arena, size_t size) {
+    if (arena->head && arena->head->size - arena->head->used >= size)
+        return true;
+
+    // one-off block of the exact size: regular growth continues from where it was
+    if (size > SIZE_MAX - sizeof(ini_arena_block) - INI_ARENA_ALIGNMENT)
+        return false;
+    return _block_new(arena, size + INI_ARENA_ALIGNMENT) != NULL;
+}
+
+void ini_arena_adopt(ini_arena* arena, ini_arena* other) {
+    ini_arena_block* head = other->head;
+    other->head = NULL;
+    if (!head)
+        return;
+    if (!arena->head) {
+        arena->head = head;
+        return;
+    }
+
+    // donor blocks go behind the current block, so allocation continues where it was
+    ini_arena_block* tail = head;
+    while (tail->prev)
+        tail = tail->prev;
+    tail->prev = arena->head->prev;
+    arena->head->prev = head;
+}
+
+void ini_arena_release(ini_arena* arena) {
+    for (ini_arena_block* block = arena->head, *prev; block; block = prev) {
+        prev = block->prev;
+        arena->allocator.free(block, sizeof(ini_arena_block) + block->size, arena->allocator.user);
+    }
+    arena->head      = NULL;
+    arena->next_size = INI_ARENA_MIN_BLOCK_SIZE;
+}
+
+#pragma endregion
@@ -0,0 +1,112 @@
+/*******************************************************************************
+ *  @file      ini.arena.h
+ *  @brief     Bump allocator owning the whole ini object graph
+ *  @author    Young Sideways
+ *  @date      17.10.2026
+ *  @copyright © Young Sideways, 2026. All right reserved.
+ ******************************************************************************/
+
+#ifndef _INI_ARENA_H_
+#define _INI_ARENA_H_
+
+#pragma once
+
+#pragma region --- INCLUDES ---
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#pragma endregion
+
+#pragma region --- MACROS ---
+
+#define INI_ARENA_ALIGNMENT      16U          //!< alignment of ini_arena_alloc blocks
+#define INI_ARENA_MIN_BLOCK_SIZE 4096U        //!< first block size
+#define INI_ARENA_MAX_BLOCK_SIZE (16U << 20)  //!< blocks stop doubling at 16 MiB
+
+#pragma endregion
+
+#pragma region --- TYPEDEFS ---
+
+typedef struct ini_allocator   ini_allocator;
+typedef struct ini_arena_block ini_arena_block;
+typedef struct ini_arena       ini_arena;
+
+#pragma endregion
+
+#pragma region --- STRUCTS ---
+
+/**
+ *  @brief user memory hooks
+ *  @note  arena asks them only for large blocks, never per token
+ */
+struct ini_allocator {
+    void* (*alloc)(size_t size, void* user);            //!< returns NULL on fail
+    void  (*free)(void* block, size_t size, void* user); //!< receives size passed to alloc
+    void* user;                                          //!< passed to hooks as is
+};
+
+struct ini_arena {
+    ini_allocator allocator; //!< blocks source
+    ini_arena_block* head;   //!< current block, older ones are chained behind it
+    size_t next_size;        //!< size of the next block
+};
+
+#pragma endregion
+
+#pragma region --- FUNCTIONS ---
+
+/**
+ *  @brief default hooks (malloc/free)
+ */
+extern const ini_allocator ini_default_allocator;
+
+/**
+ *  @brief initializes empty arena, no memory is allocated
+ *  @param arena     - arena
+ *  @param allocator - memory hooks, NULL - ini_default_allocator
+ */
+void ini_arena_init(ini_arena* arena, const ini_allocator* allocator);
+
+/**
+ *  @brief  allocates memory block aligned by INI_ARENA_ALIGNMENT
+ *  @param  arena - arena
+ *  @param  size  - block size
+ *  @retval       - memory block, or NULL on fail
+ *  @note   blocks can't be freed one by one, they live until ini_arena_release
+ */
+void* ini_arena_alloc(ini_arena* arena, size_t size);
+
+/**
+ *  @brief  copies string without alignment padding
+ *  @param  arena - arena
+ *  @param  str   - string (not null-terminated)
+ *  @param  size  - string length
+ *  @retval       - null-terminated copy, or NULL on fail
+ */
+char* ini_arena_strdup(ini_arena* arena, const char* str, size_t size);
+
+/**
+ *  @brief makes sure that next allocations up to size bytes fit a single block
+ *  @param arena - arena
+ *  @param size  - expected total size (e.g. size of the parsed file)
+ */
+bool ini_arena_reserve(ini_arena* arena, size_t size);
+
+/**
+ *  @brief takes over all blocks of another arena with the same allocator
+ *  @param arena - arena
+ *  @param other - donor, left empty
+ */
+void ini_arena_adopt(ini_arena* arena, ini_arena* other);
+
+/**
+ *  @brief frees all blocks at once, arena stays usable
+ *  @param arena - arena
+ */
+void ini_arena_release(ini_arena* arena);
+
+#pragma endregion
+
+#endif // !_INI_ARENA_H_
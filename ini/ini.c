@@ -12,39 +12,292 @@
 #pragma region --- INCLUDES ---
 
 #include <stdlib.h>
+#include "ini.epoch.h"
 #include "ini.parser.h"
+#include "ini.snapshot.h"
+#include "ini.watch.h"
+#include "ini.writer.h"
 
 #pragma endregion
 
 
 #pragma region --- MACROS ---
 
-
+#define INI_RELOAD_NAME_SIZE 64U //!< first buffer of the change names
 
 #pragma endregion
 
 
 #pragma region --- TYPEDEFS ---
 
-
+/**
+ *  @brief change notifications of a file, see ini_watcher_create
+ */
+struct ini_watcher {
+    INI* file;       //!< reloaded file
+    ini_watch watch; //!< notifications of its path
+};
+
+/**
+ *  @brief versions of a file shared between threads, see ini_shared_create
+ */
+struct ini_shared {
+    ini_epoch domain; //!< published INI* with its readers
+};
+
+/**
+ *  @brief state of ini_reload change events
+ */
+typedef struct ini_reload_ctx {
+    INI* file;                    //!< reloaded file
+    ini_change_callback callback; //!< user callback, or NULL
+    void* user;                   //!< callback argument
+    char* name;                   //!< "section\0key\0" of the current change (allocator memory)
+    size_t capacity;              //!< allocated name
+} ini_reload_ctx;
 
 #pragma endregion
 
 #pragma region --- UTILS ---
 
+/**
+ *  @brief  copies path of the file to the arena, ini_reload and watchers open it again
+ *  @retval - false on allocation fail
+ */
+static bool _path_store(INI* file, const char* path) {
+    return (file->path = ini_arena_strdup(&file->arena, path, strlen(path))) != NULL;
+}
+
+static ini_property* _find_property(const INI* file, const char* key, const char* section) {
+    return ini_lookup_property(file, section, strlen(section), key, strlen(key));
+}
+
+/**
+ *  @brief  converts value to every bound type, the bound string is overwritten in place when it fits
+ *  @retval - false on allocation fail
+ */
+static bool _binding_fill(INI* file, ini_binding* binding, const ini_value value) {
+    binding->vint    = ini_to_int(value);
+    binding->vint64  = ini_to_int64(value);
+    binding->vdouble = ini_to_double(value);
+    binding->vbool   = ini_to_bool(value);
+
+    char number[INI_NUMBER_BUFFER_SIZE];
+    ini_string text = value.vstring;
+    if (value.type == INI_INT)
+        text = (ini_string){ number, ini_format_int(value.vint, number) };
+    else if (value.type == INI_INT64)
+        text = (ini_string){ number, ini_format_int(value.vint64, number) };
+    else if (value.type == INI_DOUBLE)
+        text = (ini_string){ number, ini_format_double(value.vdouble, number) };
+    else if (value.type == INI_BOOL)
+        text = value.vbool ? (ini_string){ "true", 4U } : (ini_string){ "false", 5U };
+    else if (!text.data)
+        text = (ini_string){ "", 0U };
+
+    if (binding->vstring && binding->capacity >= text.length) {
+        char* bound = (char*)binding->vstring;
+        memmove(bound, text.data, text.length);
+        bound[text.length] = '\0';
+        return true;
+    }
+    if (!(binding->vstring = ini_arena_strdup(&file->arena, text.data, text.length)))
+        return false;
+    binding->capacity = text.length;
+    return true;
+}
+
+/**
+ *  @brief  converts value to every bound type
+ *  @retval - binding in the arena, or NULL on allocation fail
+ */
+static ini_binding* _binding_create(INI* file, const ini_value value) {
+    ini_binding* binding = ini_arena_alloc(&file->arena, sizeof(ini_binding));
+    if (!binding)
+        return NULL;
+
+    binding->vstring  = NULL;
+    binding->capacity = 0U;
+    return _binding_fill(file, binding, value) ? binding : NULL;
+}
+
+/**
+ *  @brief  finds converted value of the property, it is created by the first call
+ *  @retval - binding, or NULL if the property isn't found
+ */
+static ini_binding* _bind(INI* file, const char* section, const char* key) {
+    if (!section)
+        section = "root";
+
+    // snapshot bindings are kept by record, the image itself is read-only
+    if (file->snapshot) {
+        const ini_snapshot_header* image = file->snapshot;
+        const ini_snapshot_property* record = ini_snapshot_find(image, section, strlen(section), key, strlen(key));
+        ini_value value = record ? ini_snapshot_value(image, record) : ini_value_default(INI_NONE);
+        if (value.type == INI_NONE)
+            return NULL;
+        if (!file->snapshot_bindings) {
+            size_t size = (size_t)image->property_count * sizeof(ini_binding*);
+            if (!(file->snapshot_bindings = ini_arena_alloc(&file->arena, size)))
+                return NULL;
+            memset(file->snapshot_bindings, 0, size);
+        }
+        ini_binding** binding = &file->snapshot_bindings[record - (const ini_snapshot_property*)((const char*)image + image->properties)];
+        if (!*binding)
+            *binding = _binding_create(file, value);
+        return *binding;
+    }
+
+    ini_property* property = _find_property(file, key, section);
+    if (!property || ini_property_value(property).type == INI_NONE)
+        return NULL;
+    if (!property->binding)
+        property->binding = _binding_create(file, ini_property_value(property));
+    return property->binding;
+}
+
+/**
+ *  @brief  finds property for ini_set_*, the missing section and property are created
+ *  @retval - property, or NULL on allocation fail, invalid names or for a snapshot file
+ */
+static ini_property* _property_ensure(INI* file, const char* section, const char* key) {
+    if (!file || !key || file->snapshot)
+        return NULL;
+    if (!section)
+        section = "root";
+
+    ini_section* found = ini_section_ensure(file, section, strlen(section));
+    return found ? ini_property_ensure(found, key, strlen(key)) : NULL;
+}
+
+/**
+ *  @brief  replaces value of the property, its bound slots are converted again
+ *  @retval - false on allocation fail
+ */
+static bool _property_assign(INI* file, ini_property* property, const ini_value value) {
+    if (!ini_property_store(property, value))
+        return false;
+    return property->binding ? _binding_fill(file, property->binding, ini_property_value(property)) : true;
+}
+
+/**
+ *  @brief  applied change of ini_reload: bound slots get the new value, the user callback gets names
+ */
+static void _reload_hook(ini_change_type type, ini_section* section, ini_property* property, void* user) {
+    ini_reload_ctx* ctx = user;
+    ini_value value = ini_value_default(INI_NONE);
+    if (property && type != INI_CHANGE_REMOVED) {
+        value = ini_property_value(property);
+        if (property->binding)
+            _binding_fill(ctx->file, property->binding, value);
+    }
+    if (!ctx->callback)
+        return;
+
+    size_t length = 0U; //!< dotted name with '\0'
+    for (const ini_section* part = section; part; part = part->parent)
+        length += part->name.length + 1U;
+    size_t size = length + (property ? property->key.length + 1U : 0U);
+    if (size > ctx->capacity) {
+        const ini_allocator* allocator = &ctx->file->arena.allocator;
+        size_t capacity = ctx->capacity ? ctx->capacity : INI_RELOAD_NAME_SIZE;
+        while (capacity < size)
+            capacity *= 2U;
+        char* name = allocator->alloc(capacity, allocator->user);
+        if (!name)
+            return;
+        if (ctx->name)
+            allocator->free(ctx->name, ctx->capacity, allocator->user);
+        ctx->name     = name;
+        ctx->capacity = capacity;
+    }
+
+    // the dotted name is written from the tail
+    char* str = ctx->name + length - 1U;
+    *str = '\0';
+    for (const ini_section* part = section; part; part = part->parent) {
+        str -= part->name.length;
+        memcpy(str, part->name.data, part->name.length);
+        if (part->parent)
+            *(--str) = '.';
+    }
+    char* key = NULL;
+    if (property) {
+        key = ctx->name + length;
+        memcpy(key, property->key.data, property->key.length);
+        key[property->key.length] = '\0';
+    }
+
+    ini_change change = { .type = type, .section = ctx->name, .key = key, .value = value };
+    ctx->callback(&change, ctx->user);
+}
+
+/**
+ *  @brief ini_write output to FILE* (user)
+ */
+static bool _file_sink(const char* data, size_t size, void* user) {
+    return fwrite(data, 1U, size, (FILE*)user) == size;
+}
+
+/**
+ *  @brief makes version read only for its readers: subsection lists are sorted, names are frozen and lazy values are typed in advance
+ */
+static void _version_freeze(INI* file) {
+    ini_section_tree_sort(file);
+    // without the frozen tables lookups just go through the hash tables
+    ini_tables_freeze(file);
+    if (!file->lazy)
+        return;
+    // properties of the whole file are typed in a single linear pass over its store
+    ini_property_walk iter;
+    ini_property_walk_init(&iter, file, NULL);
+    for (ini_property* property; (property = ini_property_walk_next(&iter)); )
+        ini_property_value(property);
+}
+
+static void _version_release(void* version, void* user) {
+    (void)user;
+    ini_destroy(version);
+}
+
 
 
 #pragma endregion
 
 #pragma region --- CONSTRUCTORS / DESTRUCTORS ---
 
-INI* ini_create() {
-    INI* ini = (INI*)malloc(sizeof(INI));
+INI* ini_create(_NULLABLE const ini_allocator* allocator) {
+    if (!allocator)
+        allocator = &ini_default_allocator;
+
+    INI* ini = (INI*)allocator->alloc(sizeof(INI), allocator->user);
     if (ini) {
+        ini_arena_init(&ini->arena, allocator);
         ini->path     = NULL;
-        ini->sections = NULL;
-        ini->size     = 0U;
-        ini->capacity = 0U;
+        ini->mapping  = (ini_mapping){ .data = NULL, .size = 0U, .handle = 0 };
+        ini->mapped   = false;
+        ini->lazy     = false;
+        ini->snapshot = NULL;
+        ini->snapshot_bindings = NULL;
+        ini_store_init(&ini->section_store, sizeof(ini_section));
+        ini_store_init(&ini->property_store, sizeof(ini_property));
+        ini_table_init(&ini->sections, &ini->section_store);
+        ini->frozen = NULL;
+        ini->tree  = (ini_section_list){ .items = NULL, .count = 0U, .capacity = 0U, .sorted = true };
+        ini->regions      = NULL;
+        ini->region_count = 0U;
+        ini_store_init(&ini->atom_store, sizeof(ini_atom));
+        ini_table_init(&ini->atoms, &ini->atom_store);
+        ini->diagnostics         = NULL;
+        ini->diagnostic_count    = 0U;
+        ini->diagnostic_capacity = 0U;
+        ini->last_error          = EINI_NO;
+
+        // "root" is always the first section, the parser and the writer rely on it
+        if (!ini_section_ensure(ini, "root", sizeof("root") - 1U)) {
+            ini_destroy(ini);
+            return NULL;
+        }
     }
     return ini;
 }
@@ -55,32 +308,471 @@ INI* ini_open(_IN const char* path) {
     if (!*path)
         return NULL;
 
-    INI* ini = ini_create();
-    if (ini) {
-        ini->path = path;
-        ini_tokenize(ini);
+    INI* ini = ini_create(NULL);
+    if (!ini)
+        return NULL;
+
+    if (!_path_store(ini, path)) {
+        ini_destroy(ini);
+        return NULL;
     }
+    ini_tokenize(ini);
     return ini;
 }
 
+INI* ini_open_mapped(_IN const char* path) {
+    if (!path)
+        return NULL;
+    if (!*path)
+        return NULL;
+
+    INI* ini = ini_create(NULL);
+    if (!ini)
+        return NULL;
+
+    if (!_path_store(ini, path) || !ini_mapping_open(&ini->mapping, path)) {
+        ini_destroy(ini);
+        return NULL;
+    }
+    ini->mapped = true;
+    ini_tokenize_buffer(ini, ini->mapping.data, ini->mapping.size, false);
+    return ini;
+}
+
+INI* ini_open_lazy(_IN const char* path) {
+    if (!path)
+        return NULL;
+    if (!*path)
+        return NULL;
+
+    INI* ini = ini_create(NULL);
+    if (!ini)
+        return NULL;
+
+    if (!_path_store(ini, path) || !ini_mapping_open(&ini->mapping, path)) {
+        ini_destroy(ini);
+        return NULL;
+    }
+    ini->mapped = true;
+    ini->lazy   = true;
+    ini_tokenize_buffer(ini, ini->mapping.data, ini->mapping.size, false);
+    return ini;
+}
+
+INI* ini_open_parallel(_IN const char* path, _IN unsigned threads) {
+    if (!path)
+        return NULL;
+    if (!*path)
+        return NULL;
+
+    INI* ini = ini_create(NULL);
+    if (!ini)
+        return NULL;
+
+    if (!_path_store(ini, path) || !ini_mapping_open(&ini->mapping, path)) {
+        ini_destroy(ini);
+        return NULL;
+    }
+    ini->mapped = true;
+    ini_tokenize_parallel(ini, ini->mapping.data, ini->mapping.size, threads);
+    return ini;
+}
+
+INI* ini_load_snapshot(_IN const char* path) {
+    if (!path)
+        return NULL;
+    if (!*path)
+        return NULL;
+
+    INI* ini = ini_create(NULL);
+    if (!ini)
+        return NULL;
+
+    if (!_path_store(ini, path) || !ini_mapping_open(&ini->mapping, path)) {
+        ini_destroy(ini);
+        return NULL;
+    }
+    ini->mapped = true;
+    if (!(ini->snapshot = ini_snapshot_check(ini->mapping.data, ini->mapping.size))) {
+        ini_destroy(ini);
+        return NULL;
+    }
+    return ini;
+}
+
+void ini_destroy(_IN INI* ini) {
+    if (!ini)
+        return;
+
+    // every section, property, table and copied token lives in the arena
+    ini_allocator allocator = ini->arena.allocator;
+    if (ini->regions)
+        allocator.free(ini->regions, ini->region_count * sizeof(ini_region), allocator.user);
+    ini_arena_release(&ini->arena);
+
+    // views die with the mapping, so it goes last
+    ini_mapping_close(&ini->mapping);
+    allocator.free(ini, sizeof(INI), allocator.user);
+}
+
 #pragma endregion
 
 #pragma region --- FUNCIONS ---
 
-extern struct ini_parse_error {
-    ini_parse_error_type type;
-    int row;
-} ini_parse_error;
-extern const char const* const ini_parse_errors[];
+ini_value ini_get_value(INI* file, const char* key, _NULLABLE const char* section) {
+    if (!file || !key)
+        return ini_value_default(INI_NONE);
+    if (!section)
+        section = "root";
+
+    if (file->snapshot)
+        return ini_snapshot_get_value(file->snapshot, section, strlen(section), key, strlen(key));
+
+    ini_property* property = _find_property(file, key, section);
+    if (!property)
+        return ini_value_default(INI_NONE);
+    return ini_property_value(property);
+}
+
+const int* ini_bind_int(INI* file, _NULLABLE const char* section, const char* key, int def) {
+    if (!file || !key)
+        return NULL;
+
+    ini_binding* binding = _bind(file, section, key);
+    if (binding)
+        return &binding->vint;
+    int* slot = ini_arena_alloc(&file->arena, sizeof(int));
+    if (slot)
+        *slot = def;
+    return slot;
+}
+
+const int64_t* ini_bind_int64(INI* file, _NULLABLE const char* section, const char* key, int64_t def) {
+    if (!file || !key)
+        return NULL;
+
+    ini_binding* binding = _bind(file, section, key);
+    if (binding)
+        return &binding->vint64;
+    int64_t* slot = ini_arena_alloc(&file->arena, sizeof(int64_t));
+    if (slot)
+        *slot = def;
+    return slot;
+}
+
+const double* ini_bind_double(INI* file, _NULLABLE const char* section, const char* key, double def) {
+    if (!file || !key)
+        return NULL;
+
+    ini_binding* binding = _bind(file, section, key);
+    if (binding)
+        return &binding->vdouble;
+    double* slot = ini_arena_alloc(&file->arena, sizeof(double));
+    if (slot)
+        *slot = def;
+    return slot;
+}
+
+const bool* ini_bind_bool(INI* file, _NULLABLE const char* section, const char* key, bool def) {
+    if (!file || !key)
+        return NULL;
+
+    ini_binding* binding = _bind(file, section, key);
+    if (binding)
+        return &binding->vbool;
+    bool* slot = ini_arena_alloc(&file->arena, sizeof(bool));
+    if (slot)
+        *slot = def;
+    return slot;
+}
+
+const char* const* ini_bind_str(INI* file, _NULLABLE const char* section, const char* key, _NULLABLE const char* def) {
+    if (!file || !key)
+        return NULL;
+
+    ini_binding* binding = _bind(file, section, key);
+    if (binding)
+        return &binding->vstring;
+    const char** slot = ini_arena_alloc(&file->arena, sizeof(const char*));
+    if (slot && (*slot = def) && !(*slot = ini_arena_strdup(&file->arena, def, strlen(def))))
+        return NULL;
+    return slot;
+}
+
+ini_key_handle ini_intern(INI* file, const char* str) {
+    if (!file || !str)
+        return 0U;
+
+    size_t size = strlen(str);
+    ini_atom* atom = ini_atom_intern(file, str, size, true);
+    if (!atom)
+        return 0U;
+    if (!file->snapshot && !atom->section)
+        atom->section = ini_find_section(file, str, size);
+    return atom->handle;
+}
+
+ini_value ini_get_value_handle(const INI* file, ini_key_handle key, ini_key_handle section) {
+    if (!file)
+        return ini_value_default(INI_NONE);
+    const ini_atom* key_atom = ini_atom_get(file, key);
+    const ini_atom* section_atom = ini_atom_get(file, section);
+    if (!key_atom || (section && !section_atom))
+        return ini_value_default(INI_NONE);
+
+    ini_string name = section_atom ? section_atom->string : (ini_string){ "root", sizeof("root") - 1 };
+    if (file->snapshot)
+        return ini_snapshot_get_value(file->snapshot, name.data, name.length, key_atom->string.data, key_atom->string.length);
+
+    // the section is resolved by ini_intern, unless it was interned before the section was parsed
+    const ini_section* found = section_atom ? section_atom->section : NULL;
+    if ((!found || found->removed) && !(found = ini_find_section(file, name.data, name.length)))
+        return ini_value_default(INI_NONE);
+    ini_property* property = ini_find_property_atom(found, key_atom);
+    if (!property)
+        return ini_value_default(INI_NONE);
+    return ini_property_value(property);
+}
+
+size_t ini_get_values(INI* file, const ini_query* queries, size_t count, ini_value* out) {
+    if (!file || !queries || !out)
+        return 0U;
+
+    size_t found = 0U;
+    ini_property* properties[INI_LOOKUP_BATCH];
+    for (size_t first = 0U; first < count; first += INI_LOOKUP_BATCH) {
+        size_t size = (count - first < INI_LOOKUP_BATCH) ? count - first : INI_LOOKUP_BATCH;
+        if (!file->snapshot)
+            ini_lookup_properties(file, queries + first, size, properties);
+
+        for (size_t i = 0; i < size; i++) {
+            const ini_query* query = &queries[first + i];
+            ini_value* value = &out[first + i];
+            if (file->snapshot) {
+                const char* section = query->section ? query->section : "root";
+                *value = query->key ? ini_snapshot_get_value(file->snapshot, section, strlen(section), query->key, strlen(query->key))
+                                    : ini_value_default(INI_NONE);
+            }
+            else
+                *value = properties[i] ? ini_property_value(properties[i]) : ini_value_default(INI_NONE);
+            found += value->type != INI_NONE;
+        }
+    }
+    return found;
+}
 
-ini_parse_error_type ini_get_parse_error() {
-    return ini_parse_error.type;
+bool ini_freeze(_IN INI* file) {
+    if (!file)
+        return false;
+    // a snapshot image is queried through the same tables already
+    return file->snapshot || ini_tables_freeze(file);
+}
+
+bool ini_set_int(INI* file, _NULLABLE const char* section, const char* key, int value) {
+    ini_property* property = _property_ensure(file, section, key);
+    return property && _property_assign(file, property, (ini_value){ .type = INI_INT, .vint = value });
+}
+
+bool ini_set_double(INI* file, _NULLABLE const char* section, const char* key, double value) {
+    ini_property* property = _property_ensure(file, section, key);
+    return property && _property_assign(file, property, (ini_value){ .type = INI_DOUBLE, .vdouble = value });
+}
+
+bool ini_set_bool(INI* file, _NULLABLE const char* section, const char* key, bool value) {
+    ini_property* property = _property_ensure(file, section, key);
+    return property && _property_assign(file, property, (ini_value){ .type = INI_BOOL, .vbool = value });
+}
+
+bool ini_set_str(INI* file, _NULLABLE const char* section, const char* key, const char* value) {
+    // the text format has no multiline values
+    if (!value || strpbrk(value, "\r\n"))
+        return false;
+    ini_property* property = _property_ensure(file, section, key);
+    return property && _property_assign(file, property, (ini_value){ .type = INI_STRING, .vstring = { value, strlen(value) } });
+}
+
+bool ini_add_section(INI* file, const char* section) {
+    if (!file || !section || file->snapshot)
+        return false;
+    return ini_section_ensure(file, section, strlen(section)) != NULL;
+}
+
+bool ini_remove_key(INI* file, _NULLABLE const char* section, const char* key) {
+    if (!file || !key || file->snapshot)
+        return false;
+    if (!section)
+        section = "root";
+
+    ini_property* property = _find_property(file, key, section);
+    if (!property)
+        return false;
+    ini_property_remove(property);
+    return true;
+}
+
+bool ini_remove_section(INI* file, const char* section) {
+    if (!file || !section || file->snapshot)
+        return false;
+
+    // "root" stays, it is the section of properties before any declaration
+    ini_section* found = ini_find_section(file, section, strlen(section));
+    if (!found || found == ini_find_section(file, "root", sizeof("root") - 1U))
+        return false;
+    ini_section_remove(found);
+    return true;
+}
+
+bool ini_save_snapshot(_IN const INI* file, _IN const char* path) {
+    if (!file || !path)
+        return false;
+
+    FILE* stream = fopen(path, "wb");
+    if (!stream)
+        return false;
+    bool written = ini_snapshot_write(file, stream);
+    return (fclose(stream) == 0) && written;
+}
+
+bool ini_write(_IN const INI* file, ini_sink sink, _NULLABLE void* user) {
+    return ini_text_write(file, sink, user);
+}
+
+bool ini_save(_IN const INI* file, _IN const char* path) {
+    if (!file || !path)
+        return false;
+
+    FILE* stream = fopen(path, "wb");
+    if (!stream)
+        return false;
+    bool written = ini_text_write(file, _file_sink, stream);
+    return (fclose(stream) == 0) && written;
+}
+
+bool ini_reload(_IN INI* file, _NULLABLE ini_change_callback callback, _NULLABLE void* user) {
+    if (!file || !file->path || file->snapshot)
+        return false;
+
+    // the new text is mapped apart: views of a mapped file still point into its own mapping
+    ini_mapping mapping;
+    if (!ini_mapping_open(&mapping, file->path))
+        return false;
+
+    char empty[1] = { '\0' };
+    ini_reload_ctx ctx = { .file = file, .callback = callback, .user = user, .name = NULL, .capacity = 0U };
+    bool updated = ini_tokenize_update(file, mapping.data ? mapping.data : empty, mapping.size, _reload_hook, &ctx);
+    ini_mapping_close(&mapping);
+
+    if (ctx.name)
+        file->arena.allocator.free(ctx.name, ctx.capacity, file->arena.allocator.user);
+    return updated;
+}
+
+ini_watcher* ini_watcher_create(_IN INI* file) {
+    if (!file || !file->path || file->snapshot)
+        return NULL;
+
+    const ini_allocator* allocator = &file->arena.allocator;
+    ini_watcher* watcher = allocator->alloc(sizeof(ini_watcher), allocator->user);
+    if (!watcher)
+        return NULL;
+    watcher->file = file;
+    if (!ini_watch_open(&watcher->watch, file->path)) {
+        allocator->free(watcher, sizeof(ini_watcher), allocator->user);
+        return NULL;
+    }
+    return watcher;
+}
+
+int ini_watcher_poll(_IN ini_watcher* watcher, _IN int timeout, _NULLABLE ini_change_callback callback, _NULLABLE void* user) {
+    if (!watcher)
+        return -1;
+
+    int changed = ini_watch_wait(&watcher->watch, timeout);
+    if (changed <= 0)
+        return changed;
+    return ini_reload(watcher->file, callback, user) ? 1 : -1;
+}
+
+void ini_watcher_destroy(_IN ini_watcher* watcher) {
+    if (!watcher)
+        return;
+
+    ini_allocator allocator = watcher->file->arena.allocator;
+    ini_watch_close(&watcher->watch);
+    allocator.free(watcher, sizeof(ini_watcher), allocator.user);
+}
+
+ini_shared* ini_shared_create(_IN INI* file) {
+    if (!file)
+        return NULL;
+
+    const ini_allocator* allocator = &file->arena.allocator;
+    ini_shared* shared = allocator->alloc(sizeof(ini_shared), allocator->user);
+    if (!shared)
+        return NULL;
+    _version_freeze(file);
+    ini_epoch_init(&shared->domain, file, _version_release, NULL, allocator);
+    return shared;
+}
+
+void ini_shared_destroy(_IN ini_shared* shared) {
+    if (!shared)
+        return;
+
+    ini_allocator allocator = shared->domain.allocator;
+    ini_epoch_free(&shared->domain);
+    allocator.free(shared, sizeof(ini_shared), allocator.user);
+}
+
+ini_reader* ini_reader_create(_IN ini_shared* shared) {
+    return shared ? ini_epoch_join(&shared->domain) : NULL;
+}
+
+void ini_reader_destroy(_IN ini_reader* reader) {
+    if (reader)
+        ini_epoch_leave(reader);
+}
+
+INI* ini_acquire_snapshot(_IN ini_reader* reader) {
+    return ini_epoch_enter(reader);
+}
+
+void ini_release_snapshot(_IN ini_reader* reader) {
+    ini_epoch_exit(reader);
+}
+
+bool ini_publish(_IN ini_shared* shared, _IN INI* file) {
+    if (!shared || !file)
+        return false;
+
+    _version_freeze(file);
+    return ini_epoch_publish(&shared->domain, file);
+}
+
+size_t ini_shared_collect(_IN ini_shared* shared) {
+    return shared ? ini_epoch_collect(&shared->domain) : 0U;
+}
+
+extern const char* const ini_parse_errors[];
+
+ini_parse_error_type ini_get_parse_error(_IN const INI* file) {
+    return file ? file->last_error : EINI_NPAC;
+}
+
+size_t ini_get_diagnostic_count(_IN const INI* file) {
+    return file ? file->diagnostic_count : 0U;
+}
+
+const ini_diagnostic* ini_get_diagnostic(_IN const INI* file, _IN size_t index) {
+    if (!file || index >= file->diagnostic_count)
+        return NULL;
+    return &file->diagnostics[index];
 }
 
-const char* ini_parse_error_stringify() {
-    char buffer[256];
-    snprintf(buffer, 256, ini_parse_errors[ini_parse_error.type], ini_parse_error.row);
-    return buffer;
+int ini_parse_error_stringify(_IN const ini_diagnostic* diagnostic, _OUT char* buffer, _IN size_t size) {
+    if (!diagnostic || (!buffer && size))
+        return -1;
+    return snprintf(buffer, size, ini_parse_errors[diagnostic->type], diagnostic->row, diagnostic->column);
 }
 
 #pragma endregion
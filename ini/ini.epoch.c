@@ -0,0 +1,259 @@
+/*******************************************************************************
+ *  @file      ini.epoch.c
+ *  @brief     Epoch based reclamation of published versions
+ *  @author    Young Sideways
+ *  @date      17.10.2026
+ *  @copyright © Young Sideways, 2026. All right reserved.
+ ******************************************************************************/
+
+#include "ini.epoch.h"
+
+#pragma region --- INCLUDES ---
+
+#ifdef _WIN32
+#   define WIN32_LEAN_AND_MEAN
+#   include <windows.h>
+#elif defined(__linux__)
+#   include <unistd.h>
+#   include <sys/syscall.h>
+#endif
+
+#pragma endregion
+
+#pragma region --- MACROS ---
+
+// commands of the Linux membarrier syscall (linux/membarrier.h)
+#define INI_MEMBARRIER_PRIVATE_EXPEDITED          (1 << 3)
+#define INI_MEMBARRIER_REGISTER_PRIVATE_EXPEDITED (1 << 4)
+
+#pragma endregion
+
+#pragma region --- INTERNAL ---
+
+#ifdef _MSC_VER
+
+static inline size_t _load_size(const volatile size_t* ptr) {
+    return (size_t)ReadULongPtrAcquire((const volatile ULONG_PTR*)ptr);
+}
+
+static inline void* _load_pointer(void* const volatile* ptr) {
+    return ReadPointerAcquire((PVOID const volatile*)ptr);
+}
+
+static inline void _store_size(volatile size_t* ptr, size_t value) {
+    WriteULongPtrRelease((volatile ULONG_PTR*)ptr, (ULONG_PTR)value);
+}
+
+static inline void _store_size_relaxed(volatile size_t* ptr, size_t value) {
+    WriteULongPtrNoFence((volatile ULONG_PTR*)ptr, (ULONG_PTR)value);
+}
+
+static inline void _store_long(volatile long* ptr, long value) {
+    WriteRelease(ptr, value);
+}
+
+static inline void* _exchange_pointer(void* volatile* ptr, void* value) {
+    return InterlockedExchangePointer(ptr, value);
+}
+
+static inline bool _cas_pointer(void* volatile* ptr, void* expected, void* value) {
+    return InterlockedCompareExchangePointer(ptr, value, expected) == expected;
+}
+
+static inline bool _cas_long(volatile long* ptr, long expected, long value) {
+    return InterlockedCompareExchange(ptr, value, expected) == expected;
+}
+
+#   define _full_fence()     MemoryBarrier()
+#   define _compiler_fence() _ReadWriteBarrier()
+
+#else
+
+static inline size_t _load_size(const volatile size_t* ptr) {
+    return __atomic_load_n(ptr, __ATOMIC_ACQUIRE);
+}
+
+static inline void* _load_pointer(void* const volatile* ptr) {
+    return __atomic_load_n(ptr, __ATOMIC_ACQUIRE);
+}
+
+static inline void _store_size(volatile size_t* ptr, size_t value) {
+    __atomic_store_n(ptr, value, __ATOMIC_RELEASE);
+}
+
+static inline void _store_size_relaxed(volatile size_t* ptr, size_t value) {
+    __atomic_store_n(ptr, value, __ATOMIC_RELAXED);
+}
+
+static inline void _store_long(volatile long* ptr, long value) {
+    __atomic_store_n(ptr, value, __ATOMIC_RELEASE);
+}
+
+static inline void* _exchange_pointer(void* volatile* ptr, void* value) {
+    return __atomic_exchange_n(ptr, value, __ATOMIC_SEQ_CST);
+}
+
+static inline bool _cas_pointer(void* volatile* ptr, void* expected, void* value) {
+    return __atomic_compare_exchange_n(ptr, &expected, value, false, __ATOMIC_SEQ_CST, __ATOMIC_RELAXED);
+}
+
+static inline bool _cas_long(volatile long* ptr, long expected, long value) {
+    return __atomic_compare_exchange_n(ptr, &expected, value, false, __ATOMIC_SEQ_CST, __ATOMIC_RELAXED);
+}
+
+#   define _full_fence()     __atomic_thread_fence(__ATOMIC_SEQ_CST)
+#   define _compiler_fence() __atomic_signal_fence(__ATOMIC_SEQ_CST)
+
+#endif
+
+/**
+ *  @brief  prepares flushing of the other threads
+ *  @retval - false if the system can't do it, readers use full fences then
+ */
+static bool _flush_register(void) {
+#ifdef _WIN32
+    return true;
+#elif defined(__linux__) && defined(SYS_membarrier)
+    return syscall(SYS_membarrier, INI_MEMBARRIER_REGISTER_PRIVATE_EXPEDITED, 0) == 0;
+#else
+    return false;
+#endif
+}
+
+/**
+ *  @brief makes slot epochs of every reader visible to the writer,
+ *         pairs with the compiler fence of ini_epoch_enter
+ */
+static void _flush_readers(const ini_epoch* domain) {
+    if (!domain->asymmetric) {
+        _full_fence();
+        return;
+    }
+#ifdef _WIN32
+    FlushProcessWriteBuffers();
+#elif defined(__linux__) && defined(SYS_membarrier)
+    syscall(SYS_membarrier, INI_MEMBARRIER_PRIVATE_EXPEDITED, 0);
+#endif
+}
+
+#pragma endregion
+
+#pragma region --- FUNCTIONS ---
+
+void ini_epoch_init(ini_epoch* domain, void* version, ini_epoch_release release, void* user, const ini_allocator* allocator) {
+    domain->current    = version;
+    domain->epoch      = 1U;
+    domain->readers    = NULL;
+    domain->retired    = NULL;
+    domain->pending    = 0U;
+    domain->asymmetric = _flush_register();
+    domain->release    = release;
+    domain->user       = user;
+    domain->allocator  = allocator ? *allocator : ini_default_allocator;
+}
+
+void ini_epoch_free(ini_epoch* domain) {
+    const ini_allocator* allocator = &domain->allocator;
+    for (ini_epoch_retired* record = domain->retired, *next; record; record = next) {
+        next = record->next;
+        domain->release(record->version, domain->user);
+        allocator->free(record, sizeof(ini_epoch_retired), allocator->user);
+    }
+    for (ini_epoch_reader* reader = domain->readers, *next; reader; reader = next) {
+        next = reader->next;
+        allocator->free(reader, sizeof(ini_epoch_reader), allocator->user);
+    }
+    if (domain->current)
+        domain->release(domain->current, domain->user);
+
+    domain->current = NULL;
+    domain->readers = NULL;
+    domain->retired = NULL;
+    domain->pending = 0U;
+}
+
+ini_epoch_reader* ini_epoch_join(ini_epoch* domain) {
+    for (ini_epoch_reader* reader = _load_pointer((void* const volatile*)&domain->readers); reader; reader = reader->next)
+        if (!reader->used && _cas_long(&reader->used, 0L, 1L))
+            return reader;
+
+    const ini_allocator* allocator = &domain->allocator;
+    ini_epoch_reader* reader = allocator->alloc(sizeof(ini_epoch_reader), allocator->user);
+    if (!reader)
+        return NULL;
+    reader->epoch  = INI_EPOCH_IDLE;
+    reader->domain = domain;
+    reader->used   = 1L;
+    do
+        reader->next = _load_pointer((void* const volatile*)&domain->readers);
+    while (!_cas_pointer((void* volatile*)&domain->readers, reader->next, reader));
+    return reader;
+}
+
+void ini_epoch_leave(ini_epoch_reader* reader) {
+    _store_size(&reader->epoch, INI_EPOCH_IDLE);
+    _store_long(&reader->used, 0L);
+}
+
+void* ini_epoch_enter(ini_epoch_reader* reader) {
+    const ini_epoch* domain = reader->domain;
+    _store_size_relaxed(&reader->epoch, _load_size(&domain->epoch));
+    // the epoch must be visible before the version is read, see _flush_readers
+    if (domain->asymmetric)
+        _compiler_fence();
+    else
+        _full_fence();
+    return _load_pointer(&domain->current);
+}
+
+void ini_epoch_exit(ini_epoch_reader* reader) {
+    _store_size(&reader->epoch, INI_EPOCH_IDLE);
+}
+
+bool ini_epoch_publish(ini_epoch* domain, void* version) {
+    const ini_allocator* allocator = &domain->allocator;
+    ini_epoch_retired* record = allocator->alloc(sizeof(ini_epoch_retired), allocator->user);
+    if (!record)
+        return false;
+
+    // a reader, that sees the new epoch, sees the new version too
+    record->version = _exchange_pointer(&domain->current, version);
+    record->epoch   = domain->epoch + 1U;
+    _store_size(&domain->epoch, record->epoch);
+    record->next    = domain->retired;
+    domain->retired = record;
+    domain->pending++;
+
+    ini_epoch_collect(domain);
+    return true;
+}
+
+size_t ini_epoch_collect(ini_epoch* domain) {
+    if (!domain->retired)
+        return 0U;
+
+    _flush_readers(domain);
+    size_t oldest = INI_EPOCH_IDLE;
+    for (const ini_epoch_reader* reader = _load_pointer((void* const volatile*)&domain->readers); reader; reader = reader->next) {
+        size_t epoch = _load_size(&reader->epoch);
+        if (epoch < oldest)
+            oldest = epoch;
+    }
+
+    // records are newest first, so everything after the first free one is free too
+    ini_epoch_retired** link = &domain->retired;
+    while (*link && (*link)->epoch > oldest)
+        link = &(*link)->next;
+
+    const ini_allocator* allocator = &domain->allocator;
+    for (ini_epoch_retired* record = *link, *next; record; record = next) {
+        next = record->next;
+        domain->release(record->version, domain->user);
+        allocator->free(record, sizeof(ini_epoch_retired), allocator->user);
+        domain->pending--;
+    }
+    *link = NULL;
+    return domain->pending;
+}
+
+#pragma endregion
@@ -0,0 +1,147 @@
+/*******************************************************************************
+ *  @file      ini.epoch.h
+ *  @brief     Epoch based reclamation of published versions
+ *  @author    Young Sideways
+ *  @date      17.10.2026
+ *  @copyright © Young Sideways, 2026. All right reserved.
+ ******************************************************************************/
+
+#ifndef _INI_EPOCH_H_
+#define _INI_EPOCH_H_
+
+#pragma once
+
+#pragma region --- INCLUDES ---
+
+#include "ini.arena.h"
+
+#pragma endregion
+
+#pragma region --- MACROS ---
+
+#define INI_EPOCH_IDLE       SIZE_MAX //!< epoch of a reader without a version
+#define INI_EPOCH_CACHE_LINE 64U      //!< readers are padded to it, so their slots are never shared
+
+#pragma endregion
+
+#pragma region --- TYPEDEFS ---
+
+typedef struct ini_epoch         ini_epoch;
+typedef struct ini_epoch_reader  ini_epoch_reader;
+typedef struct ini_epoch_retired ini_epoch_retired;
+
+typedef void (*ini_epoch_release)(void* version, void* user); //!< frees version no reader can see
+
+#pragma endregion
+
+#pragma region --- STRUCTS ---
+
+/**
+ *  @brief  slot of a reader thread
+ *  @note   only the owner thread writes the epoch, the writer reads it
+ */
+struct ini_epoch_reader {
+    volatile size_t epoch;    //!< epoch of the entered version, INI_EPOCH_IDLE - none
+    ini_epoch* domain;        //!< owner domain
+    ini_epoch_reader* next;   //!< next slot of the domain
+    volatile long used;       //!< the slot is taken by a thread
+    char padding[INI_EPOCH_CACHE_LINE - sizeof(size_t) - 2U * sizeof(void*) - sizeof(long)];
+};
+
+/**
+ *  @brief replaced version waiting for the readers
+ */
+struct ini_epoch_retired {
+    void* version;            //!< replaced version
+    size_t epoch;             //!< first epoch without it
+    ini_epoch_retired* next;  //!< older retired version
+};
+
+/**
+ *  @brief  current version with its readers
+ *  @note   readers never block and never run an atomic read-modify-write: entering
+ *          is a store of the epoch to the own slot and a load of the version. The
+ *          writer swaps the version, bumps the epoch and frees a replaced version
+ *          once no slot keeps an older epoch. Where the system can flush store
+ *          buffers of every thread (membarrier, FlushProcessWriteBuffers), the
+ *          writer does it, and readers need only a compiler fence
+ */
+struct ini_epoch {
+    void* volatile current;                //!< published version
+    volatile size_t epoch;                 //!< bumped by every publish, starts with 1
+    ini_epoch_reader* volatile readers;    //!< slots, pushed to the head, never removed
+    ini_epoch_retired* retired;            //!< replaced versions, newest first (writer only)
+    size_t pending;                        //!< count of retired versions
+    bool asymmetric;                       //!< the writer flushes readers, they skip the full fence
+    ini_epoch_release release;             //!< frees versions
+    void* user;                            //!< release argument
+    ini_allocator allocator;               //!< slots and retired records
+};
+
+#pragma endregion
+
+#pragma region --- FUNCTIONS ---
+
+/**
+ *  @brief initializes domain
+ *  @param domain    - domain
+ *  @param version   - first version, owned by the domain
+ *  @param release   - frees replaced versions
+ *  @param user      - release argument
+ *  @param allocator - memory hooks, NULL - ini_default_allocator
+ */
+void ini_epoch_init(ini_epoch* domain, void* version, ini_epoch_release release, void* user, const ini_allocator* allocator);
+
+/**
+ *  @brief releases every version and slot
+ *  @param domain - domain without entered readers
+ */
+void ini_epoch_free(ini_epoch* domain);
+
+/**
+ *  @brief  takes reader slot, a released one is reused
+ *  @param  domain - domain
+ *  @retval        - slot of the calling thread, or NULL on allocation fail
+ *  @note   lock-free, may be called by any thread at any time
+ */
+ini_epoch_reader* ini_epoch_join(ini_epoch* domain);
+
+/**
+ *  @brief gives slot back to the domain
+ *  @param reader - slot without an entered version
+ */
+void ini_epoch_leave(ini_epoch_reader* reader);
+
+/**
+ *  @brief  enters current version
+ *  @param  reader - slot of the calling thread
+ *  @retval        - version, valid until ini_epoch_exit or the next ini_epoch_enter of the slot
+ */
+void* ini_epoch_enter(ini_epoch_reader* reader);
+
+/**
+ *  @brief exits entered version
+ *  @param reader - slot of the calling thread
+ */
+void ini_epoch_exit(ini_epoch_reader* reader);
+
+/**
+ *  @brief  replaces current version, the old one is retired
+ *  @param  domain  - domain
+ *  @param  version - new version, owned by the domain
+ *  @retval         - false on allocation fail, the version isn't published then
+ *  @note   one writer at a time, retired versions are collected right away
+ */
+bool ini_epoch_publish(ini_epoch* domain, void* version);
+
+/**
+ *  @brief  frees retired versions no reader can see
+ *  @param  domain - domain
+ *  @retval        - count of versions still retired
+ *  @note   writer side, never waits for readers
+ */
+size_t ini_epoch_collect(ini_epoch* domain);
+
+#pragma endregion
+
+#endif // !_INI_EPOCH_H_
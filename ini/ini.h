@@ -21,26 +21,383 @@
 
 #pragma region --- CONSTRUCTORS / DESTRUCTORS ---
 
-INI* ini_create();
+/**
+ *  @brief  creates empty ini file with the "root" section only
+ *  @param  allocator - memory hooks for the file arena, NULL - malloc/free
+ *  @retval           - ini file, or NULL if error
+ *  @note   the whole object graph is built in a few large arena blocks
+ *          and ini_destroy frees them at once
+ */
+INI* ini_create(_NULLABLE const ini_allocator* allocator);
 INI* ini_open(_IN const char* path);
+
+/**
+ *  @brief  opens file through a memory mapping, without copying tokens
+ *  @param  path - path to the file
+ *  @retval      - ini file, or NULL if error
+ *  @note   keys, section names and string values are views into the mapping,
+ *          so they (and every ini_value taken from the file) are valid until ini_destroy
+ */
+INI* ini_open_mapped(_IN const char* path);
+
+/**
+ *  @brief  opens file through a memory mapping and parses it with several threads
+ *  @param  path    - path to the file
+ *  @param  threads - max count of threads, 0 - count of logical processors
+ *  @retval         - ini file, or NULL if error
+ *  @note   the result is the same as of ini_open_mapped (views live until ini_destroy),
+ *          files smaller than 64 KiB per thread use less threads
+ */
+INI* ini_open_parallel(_IN const char* path, _IN unsigned threads);
+
+/**
+ *  @brief  opens file as ini_open_mapped, but values are typed on first access
+ *  @param  path - path to the file
+ *  @retval      - ini file, or NULL if error
+ *  @note   properties keep the value text (INI_RAW) until ini_get_value or a bind
+ *          types it, so out of range numbers become INI_NONE values without a diagnostic.
+ *          The first access writes the property: don't share the file between threads
+ *          until its values are read
+ */
+INI* ini_open_lazy(_IN const char* path);
+
+/**
+ *  @brief  opens binary snapshot written by ini_save_snapshot, nothing is parsed
+ *  @param  path - path to the snapshot
+ *  @retval      - ini file, or NULL if the file isn't a snapshot of this version and byte order
+ *  @note   values are looked up right in the mapped image, string values are views
+ *          into it, valid until ini_destroy
+ */
+INI* ini_load_snapshot(_IN const char* path);
+
+/**
+ *  @brief releases file, unmaps it, if it was opened by ini_open_mapped
+ *  @param ini - ini file, or NULL
+ */
 void ini_destroy(_IN INI* ini);
 
 #pragma endregion
 
 #pragma region --- FUNCIONS ---
 
+/**
+ *  @brief  finds property value
+ *  @param  file    - ini file
+ *  @param  key     - property key
+ *  @param  section - dotted section name ("settings.com1"), NULL - root section
+ *  @retval         - property value, or INI_NONE value if not found
+ */
 ini_value ini_get_value(INI* file, const char* key, _NULLABLE const char* section);
 
-void* ini_to_struct(INI* file, _NULLABLE const char* format, _NULLABLE const char* section);
+/**
+ *  @brief  binds property to a slot with its value converted once (as ini_to_int)
+ *  @param  file    - ini file
+ *  @param  section - dotted section name, NULL - root section
+ *  @param  key     - property key
+ *  @param  def     - value of the slot, if the property isn't found
+ *  @retval         - slot valid until ini_destroy, or NULL if error
+ *  @note   reading the slot is a single load. Bind before the file is shared
+ *          between threads: the first bind of a property creates its slots
+ */
+const int* ini_bind_int(INI* file, _NULLABLE const char* section, const char* key, int def);
+
+/**
+ *  @brief  binds property to a slot with its value converted once (as ini_to_int64)
+ *  @see    ini_bind_int
+ */
+const int64_t* ini_bind_int64(INI* file, _NULLABLE const char* section, const char* key, int64_t def);
+
+/**
+ *  @brief  binds property to a slot with its value converted once (as ini_to_double)
+ *  @see    ini_bind_int
+ */
+const double* ini_bind_double(INI* file, _NULLABLE const char* section, const char* key, double def);
+
+/**
+ *  @brief  binds property to a slot with its value converted once (as ini_to_bool)
+ *  @see    ini_bind_int
+ */
+const bool* ini_bind_bool(INI* file, _NULLABLE const char* section, const char* key, bool def);
+
+/**
+ *  @brief  binds property to a slot with null-terminated text of its value
+ *  @param  def - text of the slot (copied), if the property isn't found, may be NULL
+ *  @see    ini_bind_int
+ */
+const char* const* ini_bind_str(INI* file, _NULLABLE const char* section, const char* key, _NULLABLE const char* def);
+
+/**
+ *  @brief  interns key or dotted section name for ini_get_value_handle
+ *  @param  file - ini file
+ *  @param  str  - key or dotted section name ("settings.com1")
+ *  @retval      - handle, valid until ini_destroy, or 0 if error
+ *  @note   keys and section names of the file share the pool, so interning an
+ *          existing one allocates nothing. Section handles resolve the section
+ *          at once, intern them after the file is parsed
+ */
+ini_key_handle ini_intern(INI* file, const char* str);
+
+/**
+ *  @brief  finds property value by interned handles, no strings are hashed or compared
+ *  @param  file    - ini file
+ *  @param  key     - handle of the property key
+ *  @param  section - handle of the dotted section name, 0 - root section
+ *  @retval         - property value, or INI_NONE value if not found
+ */
+ini_value ini_get_value_handle(const INI* file, ini_key_handle key, ini_key_handle section);
+
+/**
+ *  @brief  finds values of several properties at once
+ *  @param  file    - ini file
+ *  @param  queries - section and key of every value
+ *  @param  count   - count of queries
+ *  @param  out     - value of every query, INI_NONE value if not found
+ *  @retval         - count of found values
+ *  @note   names of a batch are hashed before any table is read, memory of the
+ *          next step of every lookup is prefetched, so cache misses of the batch
+ *          overlap instead of following one another
+ */
+size_t ini_get_values(INI* file, const ini_query* queries, size_t count, ini_value* out);
+
+/**
+ *  @brief  rebuilds section and property lookup into minimal perfect hashes of the current names
+ *  @param  file - ini file
+ *  @retval      - false on allocation fail, lookups go through the hash tables then
+ *  @note   ini_get_value and ini_bind_* probe a single slot with no collision chain,
+ *          the tables take about 6 bytes per name. Adding or removing a name
+ *          (ini_set_*, ini_remove_*, ini_reload) thaws the file, value changes don't.
+ *          Published versions (ini_publish) are frozen, snapshot images use the same tables
+ */
+bool ini_freeze(_IN INI* file);
+
+/**
+ *  @brief  sets integer value of the property, the missing section and property are created
+ *  @param  file    - ini file
+ *  @param  section - dotted section name, NULL - root section
+ *  @param  key     - property key
+ *  @param  value   - new value
+ *  @retval         - false on allocation fail, invalid names or for a snapshot file
+ *  @note   bound slots of the property get the new value. Tables grow by amortized O(1)
+ */
+bool ini_set_int(INI* file, _NULLABLE const char* section, const char* key, int value);
+
+/**
+ *  @brief  sets floating point value of the property, see ini_set_int
+ */
+bool ini_set_double(INI* file, _NULLABLE const char* section, const char* key, double value);
+
+/**
+ *  @brief  sets boolean value of the property, see ini_set_int
+ *  @note   the value is INI_BOOL, it is saved as "true" or "false"
+ *          (and read back as a string, as any text)
+ */
+bool ini_set_bool(INI* file, _NULLABLE const char* section, const char* key, bool value);
+
+/**
+ *  @brief  sets string value of the property, see ini_set_int
+ *  @param  value - single line text, it is copied
+ *  @retval       - false also for a text with line breaks
+ *  @note   a text is written over the previous one set by the file when it fits,
+ *          views returned by ini_get_value for the old text see the new one then.
+ *          A text up to INI_PACKED_INLINE characters is kept inside the property
+ */
+bool ini_set_str(INI* file, _NULLABLE const char* section, const char* key, const char* value);
+
+/**
+ *  @brief  creates section with its missing parents
+ *  @param  file    - ini file
+ *  @param  section - dotted section name
+ *  @retval         - false on allocation fail, invalid name or for a snapshot file
+ */
+bool ini_add_section(INI* file, const char* section);
+
+/**
+ *  @brief  removes property
+ *  @param  file    - ini file
+ *  @param  section - dotted section name, NULL - root section
+ *  @param  key     - property key
+ *  @retval         - false if the property isn't found
+ *  @note   memory of the property is kept until ini_destroy, as slots bound to it
+ */
+bool ini_remove_key(INI* file, _NULLABLE const char* section, const char* key);
+
+/**
+ *  @brief  removes section with its subsections and properties
+ *  @param  file    - ini file
+ *  @param  section - dotted section name, the root section isn't removed
+ *  @retval         - false if the section isn't found
+ *  @note   memory of the section is kept until ini_destroy, as slots bound to it
+ */
+bool ini_remove_section(INI* file, const char* section);
+
+/**
+ *  @brief  writes relocatable binary image of the file for ini_load_snapshot
+ *  @param  file - ini file
+ *  @param  path - path to the snapshot
+ *  @retval      - false on allocation or write fail
+ *  @note   the image is written in the native byte order
+ */
+bool ini_save_snapshot(_IN const INI* file, _IN const char* path);
+
+/**
+ *  @brief  serializes file as ini text
+ *  @param  file - ini file
+ *  @param  sink - output, gets the text by blocks of up to 64 KiB
+ *  @param  user - sink argument
+ *  @retval      - false on allocation fail, if the sink returned false, for a snapshot file,
+ *                 or for a double that isn't finite or a string with a line break
+ *  @note   sections and properties keep their declaration order, numbers are written
+ *          so that they are parsed back to the same type and value. Comments aren't kept.
+ *          Strings and booleans may come back with another type, see ini_text_write
+ */
+bool ini_write(_IN const INI* file, ini_sink sink, _NULLABLE void* user);
+
+/**
+ *  @brief  writes file as ini text, see ini_write
+ *  @param  file - ini file
+ *  @param  path - path to the output file
+ *  @retval      - false on open, allocation or write fail
+ */
+bool ini_save(_IN const INI* file, _IN const char* path);
+
+/**
+ *  @brief  reads the file by its path again and applies changes of the text
+ *  @param  file     - ini file opened by path
+ *  @param  callback - called for every applied change, NULL - no reports
+ *  @param  user     - callback argument
+ *  @retval          - false if the file can't be read, on allocation fail or for a snapshot file
+ *  @note   the text is split at top level sections, only sections with changed text are
+ *          parsed and compared, so the cost follows the change. These sections get exactly
+ *          the properties of the text, values set by ini_set_* elsewhere are kept. The first
+ *          reload compares the whole file. Bound slots get new values, slots of removed
+ *          properties keep the last one. Diagnostics cover reparsed sections only.
+ *          A mapped file keeps views into its first mapping: replace the file (as editors
+ *          save it), don't overwrite it in place
+ */
+bool ini_reload(_IN INI* file, _NULLABLE ini_change_callback callback, _NULLABLE void* user);
+
+/**
+ *  @brief  starts watching the file by its path for ini_watcher_poll
+ *  @param  file - ini file opened by path, must outlive the watcher
+ *  @retval      - watcher, or NULL if the file can't be watched
+ *  @note   inotify on Linux, change notifications on Windows, polling of the modification time elsewhere
+ */
+ini_watcher* ini_watcher_create(_IN INI* file);
+
+/**
+ *  @brief  waits for a change of the file and reloads it, see ini_reload
+ *  @param  watcher  - watcher
+ *  @param  timeout  - max wait in ms, 0 - just check, < 0 - no limit
+ *  @param  callback - called for every applied change, NULL - no reports
+ *  @param  user     - callback argument
+ *  @retval          - 1 if the file is reloaded, 0 on timeout, -1 on error
+ *  @note   the reload runs on the calling thread, so it never races with readers of the file
+ */
+int ini_watcher_poll(_IN ini_watcher* watcher, _IN int timeout, _NULLABLE ini_change_callback callback, _NULLABLE void* user);
+
+/**
+ *  @brief stops watching
+ *  @param watcher - watcher, or NULL
+ */
+void ini_watcher_destroy(_IN ini_watcher* watcher);
+
+/**
+ *  @brief  shares file between threads, later versions are given by ini_publish
+ *  @param  file - first version, owned by the shared handle
+ *  @retval      - shared handle, or NULL on allocation fail (the file isn't taken then)
+ *  @note   every published version is read only: ini_get_value, ini_get_value_handle,
+ *          ini_write, section tree queries and other calls with a const file. Values of a
+ *          lazy file are typed and subsection lists are sorted before publishing,
+ *          ini_bind_* and ini_set_* must not be called on a version
+ */
+ini_shared* ini_shared_create(_IN INI* file);
+
+/**
+ *  @brief destroys shared handle with every version and reader
+ *  @param shared - shared handle without acquired snapshots, or NULL
+ */
+void ini_shared_destroy(_IN ini_shared* shared);
+
+/**
+ *  @brief  registers reader thread
+ *  @param  shared - shared handle
+ *  @retval        - reader of the calling thread, or NULL on allocation fail
+ *  @note   lock-free, slots of destroyed readers are reused
+ */
+ini_reader* ini_reader_create(_IN ini_shared* shared);
+
+/**
+ *  @brief unregisters reader
+ *  @param reader - reader without acquired snapshot, or NULL
+ */
+void ini_reader_destroy(_IN ini_reader* reader);
+
+/**
+ *  @brief  gives the latest published version
+ *  @param  reader - reader of the calling thread
+ *  @retval        - read only version, valid until ini_release_snapshot or the next acquire of the reader
+ *  @note   never blocks and never runs an atomic read-modify-write, a reader doesn't see
+ *          other readers. A long held snapshot only delays freeing of the older versions
+ */
+INI* ini_acquire_snapshot(_IN ini_reader* reader);
+
+/**
+ *  @brief releases acquired version
+ *  @param reader - reader of the calling thread
+ */
+void ini_release_snapshot(_IN ini_reader* reader);
+
+/**
+ *  @brief  replaces the version of the readers
+ *  @param  shared - shared handle
+ *  @param  file   - new version (i.e. opened again or built by ini_parser_finish), owned by the shared handle
+ *  @retval        - false on allocation fail, the file isn't taken then
+ *  @note   one writer at a time. Readers get the new version by their next acquire, old
+ *          versions are destroyed as soon as no reader holds them, without waiting for readers
+ */
+bool ini_publish(_IN ini_shared* shared, _IN INI* file);
+
+/**
+ *  @brief  destroys replaced versions released since the last ini_publish
+ *  @param  shared - shared handle
+ *  @retval        - count of versions still held by readers
+ *  @note   writer side, for a writer that publishes rarely
+ */
+size_t ini_shared_collect(_IN ini_shared* shared);
 
 #pragma endregion
 
 #pragma region --- PARSER ADAPTER ---
 
-#ifdef _INI_PARSER_H_
-ini_parse_error_type ini_get_parse_error();
-const char* ini_parse_error_stringify();
-#endif
+/**
+ *  @brief  last parse error of the file
+ *  @param  file - ini file
+ *  @retval      - error code, EINI_NO if the file was parsed without errors
+ */
+ini_parse_error_type ini_get_parse_error(_IN const INI* file);
+
+/**
+ *  @brief  count of parse errors of the file
+ *  @param  file - ini file
+ */
+size_t ini_get_diagnostic_count(_IN const INI* file);
+
+/**
+ *  @brief  gets parse error by index, errors are sorted by position in the file
+ *  @param  file  - ini file
+ *  @param  index - error index
+ *  @retval       - error, or NULL if index is out of range
+ */
+const ini_diagnostic* ini_get_diagnostic(_IN const INI* file, _IN size_t index);
+
+/**
+ *  @brief  writes error message to the buffer
+ *  @param  diagnostic - parse error
+ *  @param  buffer     - output buffer, NULL to measure the message
+ *  @param  size       - size of the buffer
+ *  @retval            - message length (as snprintf), or -1 if error
+ */
+int ini_parse_error_stringify(_IN const ini_diagnostic* diagnostic, _OUT char* buffer, _IN size_t size);
 
 #pragma endregion
 
@@ -0,0 +1,307 @@
+/*******************************************************************************
+ *  @file      ini.lexer.c
+ *  @brief     Single pass table-driven ini lexer
+ *  @author    Young Sideways
+ *  @date      17.10.2026
+ *  @copyright © Young Sideways, 2026. All right reserved.
+ ******************************************************************************/
+
+#include "ini.lexer.h"
+
+#pragma region --- MACROS ---
+
+#define C_SPACE     0x001U //!< ' ', '\t', '\v', '\f', '\r'
+#define C_NEWLINE   0x002U //!< '\n'
+#define C_COMMENT   0x004U //!< '#', ';'
+#define C_OPEN      0x008U //!< '['
+#define C_CLOSE     0x010U //!< ']'
+#define C_DELIM     0x020U //!< '=', ':'
+#define C_ESCAPE    0x040U //!< '\\'
+#define C_NAME      0x080U //!< [0-9a-zA-Z_]
+#define C_DOT       0x100U //!< '.'
+
+#define C_KEY        (C_NAME | C_DOT)
+#define C_LINE_END   (C_NEWLINE | C_COMMENT)
+#define C_ESCAPABLE  (C_OPEN | C_CLOSE | C_COMMENT | C_ESCAPE)
+
+#define CLASS(ch) _char_class[(uint8_t)(ch)]
+
+#pragma endregion
+
+#pragma region --- CHARACTER CLASSES ---
+
+#define _ 0U
+#define S C_SPACE
+#define N C_NEWLINE
+#define C C_COMMENT
+#define O C_OPEN
+#define B C_CLOSE
+#define D C_DELIM
+#define E C_ESCAPE
+#define W C_NAME
+#define P C_DOT
+
+static const uint16_t _char_class[256] = {
+    _, _, _, _, _, _, _, _, _, S, N, S, S, S, _, _, // 00
+    _, _, _, _, _, _, _, _, _, _, _, _, _, _, _, _, // 10
+    S, _, _, C, _, _, _, _, _, _, _, _, _, _, P, _, // 20
+    W, W, W, W, W, W, W, W, W, W, D, C, _, D, _, _, // 30
+    _, W, W, W, W, W, W, W, W, W, W, W, W, W, W, W, // 40
+    W, W, W, W, W, W, W, W, W, W, W, O, E, B, _, W, // 50
+    _, W, W, W, W, W, W, W, W, W, W, W, W, W, W, W, // 60
+    W, W, W, W, W, W, W, W, W, W, W, _, _, _, _, _, // 70
+    _, _, _, _, _, _, _, _, _, _, _, _, _, _, _, _, // 80
+    _, _, _, _, _, _, _, _, _, _, _, _, _, _, _, _, // 90
+    _, _, _, _, _, _, _, _, _, _, _, _, _, _, _, _, // A0
+    _, _, _, _, _, _, _, _, _, _, _, _, _, _, _, _, // B0
+    _, _, _, _, _, _, _, _, _, _, _, _, _, _, _, _, // C0
+    _, _, _, _, _, _, _, _, _, _, _, _, _, _, _, _, // D0
+    _, _, _, _, _, _, _, _, _, _, _, _, _, _, _, _, // E0
+    _, _, _, _, _, _, _, _, _, _, _, _, _, _, _, _, // F0
+};
+
+#undef _
+#undef S
+#undef N
+#undef C
+#undef O
+#undef B
+#undef D
+#undef E
+#undef W
+#undef P
+
+#pragma endregion
+
+#pragma region --- INTERNAL ---
+
+static inline const char* _skip(const char* str, const char* end, uint16_t mask) {
+    while (str < end && (CLASS(*str) & mask))
+        str++;
+    return str;
+}
+
+/**
+ *  @brief  start of the next line
+ */
+static inline const char* _skip_line(const char* str, const char* end) {
+    const char* eol = memchr(str, '\n', (size_t)(end - str));
+    return eol ? eol + 1 : end;
+}
+
+/**
+ *  @brief  reads comment up to the end of line
+ *  @param  token - comment is stored here
+ *  @param  str   - comment marker
+ *  @retval       - start of the next line
+ */
+static const char* _lex_comment(ini_token* token, const char* str, const char* end) {
+    const char* eol = memchr(str, '\n', (size_t)(end - str));
+    const char* last = eol ? eol : end;
+    while (last > str && (CLASS(last[-1]) & C_SPACE))
+        last--;
+    token->comment.data   = str;
+    token->comment.length = (size_t)(last - str);
+    return eol ? eol + 1 : end;
+}
+
+static const char* _lex_error(ini_lexer* lexer, ini_token* token, const char* str, ini_parse_error_type error) {
+    token->type  = INI_TOKEN_ERROR;
+    token->error  = error;
+    token->row    = lexer->row;
+    token->column = (int)(str - lexer->line) + 1;
+    return _skip_line(str, lexer->end);
+}
+
+/**
+ *  @brief  reads section declaration
+ *  @param  str - open bracket
+ *  @retval     - start of the next line
+ */
+static const char* _lex_section(ini_lexer* lexer, ini_token* token, const char* str) {
+    const char* end = lexer->end;
+
+    const char* dots = _skip(str + 1, end, C_SPACE);
+    const char* name = _skip(dots, end, C_DOT);
+    str = _skip(name, end, C_NAME);
+    size_t depth = (size_t)(name - dots);
+
+    token->type        = INI_TOKEN_SECTION;
+    token->name.data   = name;
+    token->name.length = (size_t)(str - name);
+
+    str = _skip(str, end, C_SPACE);
+    if (str == end || !(CLASS(*str) & C_CLOSE)) {
+        // the only rescan: tells a bad name from a missing bracket
+        const char* eol = _skip_line(str, end);
+        return _lex_error(lexer, token, str, memchr(str, ']', (size_t)(eol - str)) ? EINI_INSEC : EINI_UNBRCK);
+    }
+    str = _skip(str + 1, end, C_SPACE);
+    if (str != end && !(CLASS(*str) & C_LINE_END))
+        return _lex_error(lexer, token, str, EINI_TLTRSH);
+    if (depth > INI_MAX_DEPTH)
+        return _lex_error(lexer, token, dots, EINI_TOODP);
+    if (depth && !token->name.length)
+        return _lex_error(lexer, token, name, EINI_INSEC);
+
+    token->depth = (uint8_t)depth;
+    if (str != end && (CLASS(*str) & C_COMMENT))
+        return _lex_comment(token, str, end);
+    return (str != end) ? str + 1 : end;
+}
+
+/**
+ *  @brief  reads property, value may continue on the next lines
+ *  @param  str - first character of the key
+ *  @retval     - start of the next line
+ */
+static const char* _lex_property(ini_lexer* lexer, ini_token* token, const char* str) {
+    const char* end = lexer->end;
+
+    const char* key = str;
+    str = _skip(str, end, C_KEY);
+    token->name.data   = key;
+    token->name.length = (size_t)(str - key);
+
+    str = _skip(str, end, C_SPACE);
+    if (!token->name.length || str == end || !(CLASS(*str) & C_DELIM))
+        return _lex_error(lexer, token, str, (str != end && (CLASS(*str) & C_OPEN)) ? EINI_LDTRSH : EINI_INVALTK);
+    str = _skip(str + 1, end, C_SPACE);
+
+    const char* value = str;
+    const char* last  = str; //!< end of the value without tailing spaces
+    while (true) {
+        // plain characters are skipped by the structural index, only the tail is trimmed
+        const char* stop = ini_scanner_next(&lexer->scanner, str);
+        const char* tail = stop;
+        while (tail > str && (CLASS(tail[-1]) & C_SPACE))
+            tail--;
+        if (tail > str)
+            last = tail;
+        if ((str = stop) == end)
+            break;
+
+        uint16_t cls = CLASS(*str);
+        if (cls & C_LINE_END)
+            break;
+        if (cls & (C_OPEN | C_CLOSE))
+            return _lex_error(lexer, token, str, EINI_INVALTK);
+
+        // escape or line continuation
+        token->escaped = true;
+        const char* next = str + 1;
+        if (next < end && (CLASS(*next) & C_ESCAPABLE)) {
+            last = str = next + 1;
+            continue;
+        }
+        next = _skip(next, end, C_SPACE);
+        if (next == end) {
+            str = end;
+            break;
+        }
+        if (CLASS(*next) & C_NEWLINE) {
+            lexer->row++;
+            lexer->line = next + 1;
+            str = _skip(next + 1, end, C_SPACE);
+            continue;
+        }
+        last = ++str; // not an escape - just a backslash
+    }
+
+    token->type         = INI_TOKEN_PROPERTY;
+    token->value.data   = value;
+    token->value.length = (size_t)(last - value);
+    if (str != end && (CLASS(*str) & C_COMMENT))
+        return _lex_comment(token, str, end);
+    return (str != end) ? str + 1 : end;
+}
+
+#pragma endregion
+
+#pragma region --- FUNCTIONS ---
+
+void ini_lexer_init(ini_lexer* lexer, const char* buffer, size_t size) {
+    lexer->cursor = buffer;
+    lexer->end    = buffer + size;
+    lexer->row    = 0;
+    lexer->line   = buffer;
+    ini_scanner_init(&lexer->scanner, buffer, buffer + size);
+}
+
+bool ini_lexer_next(ini_lexer* lexer, ini_token* token) {
+    const char* str = lexer->cursor;
+    const char* end = lexer->end;
+
+    while (str < end) {
+        lexer->row++;
+        lexer->line = str;
+        str = _skip(str, end, C_SPACE);
+        if (str == end)
+            break;
+
+        uint16_t cls = CLASS(*str);
+        if (cls & C_NEWLINE) {
+            str++;
+            continue;
+        }
+
+        token->row     = lexer->row;
+        token->column  = (int)(str - lexer->line) + 1;
+        token->error   = EINI_NO;
+        token->name    = (ini_string){ str, 0U };
+        token->value   = (ini_string){ NULL, 0U };
+        token->comment = (ini_string){ NULL, 0U };
+        token->depth   = 0U;
+        token->escaped = false;
+
+        if (cls & C_COMMENT) {
+            token->type = INI_TOKEN_COMMENT;
+            str = _lex_comment(token, str, end);
+        }
+        else if (cls & C_OPEN)
+            str = _lex_section(lexer, token, str);
+        else
+            str = _lex_property(lexer, token, str);
+
+        lexer->cursor = str;
+        return true;
+    }
+
+    lexer->cursor = end;
+    return false;
+}
+
+size_t ini_unescape(char* out, const char* value, size_t size) {
+    const char* end = value + size;
+    char* first = out;
+    char* last  = out;
+
+    while (value < end) {
+        char ch = *value;
+        if (CLASS(ch) & C_ESCAPE) {
+            const char* next = value + 1;
+            if (next < end && (CLASS(*next) & C_ESCAPABLE)) {
+                *(out++) = *next;
+                last = out;
+                value = next + 1;
+                continue;
+            }
+            next = _skip(next, end, C_SPACE);
+            if (next == end)
+                break;
+            if (CLASS(*next) & C_NEWLINE) {
+                value = _skip(next + 1, end, C_SPACE);
+                continue;
+            }
+        }
+        if (out != value)
+            *out = ch;
+        out++;
+        if (!(CLASS(ch) & C_SPACE))
+            last = out;
+        value++;
+    }
+    return (size_t)(last - first);
+}
+
+#pragma endregion
@@ -0,0 +1,105 @@
+/*******************************************************************************
+ *  @file      ini.lexer.h
+ *  @brief     Single pass table-driven ini lexer
+ *  @author    Young Sideways
+ *  @date      17.10.2026
+ *  @copyright © Young Sideways, 2026. All right reserved.
+ ******************************************************************************/
+
+#ifndef _INI_LEXER_H_
+#define _INI_LEXER_H_
+
+#pragma once
+
+#pragma region --- INCLUDES ---
+
+#include "ini.types.h"
+#include "ini.parser.h"
+#include "ini.simd.h"
+
+#pragma endregion
+
+#pragma region --- MACROS ---
+
+#define INI_MAX_DEPTH 16U //!< max count of leading dots in a subsection declaration
+
+#pragma endregion
+
+#pragma region --- TYPEDEFS ---
+
+typedef enum ini_token_type ini_token_type;
+
+typedef struct ini_token    ini_token;
+typedef struct ini_lexer    ini_lexer;
+
+#pragma endregion
+
+#pragma region --- ENUMS ---
+
+enum ini_token_type {
+    INI_TOKEN_COMMENT,  // comment line
+    INI_TOKEN_SECTION,  // [..name]
+    INI_TOKEN_PROPERTY, // key = value
+    INI_TOKEN_ERROR     // broken line, see ini_token::error
+};
+
+#pragma endregion
+
+#pragma region --- STRUCTS ---
+
+/**
+ *  @brief  token, all spans point into the lexed buffer
+ */
+struct ini_token {
+    ini_token_type type;
+    int row;                    //!< row of the first token character (row of the error for INI_TOKEN_ERROR)
+    int column;                 //!< column of the first token character (column of the error for INI_TOKEN_ERROR)
+    ini_parse_error_type error; //!< error of INI_TOKEN_ERROR
+
+    ini_string name;            //!< section name without dots / property key
+    ini_string value;           //!< raw property value without surrounding spaces
+    ini_string comment;         //!< comment with its marker, or empty span
+    uint8_t depth;              //!< count of section leading dots
+    bool escaped;               //!< value has escapes or line continuations, see ini_unescape
+};
+
+struct ini_lexer {
+    const char* cursor;  //!< start of the next line
+    const char* end;     //!< end of the buffer
+    int row;             //!< rows consumed so far
+    const char* line;    //!< start of the current row
+    ini_scanner scanner; //!< structural index of the buffer
+};
+
+#pragma endregion
+
+#pragma region --- FUNCTIONS ---
+
+/**
+ *  @brief initializes lexer, buffer isn't modified and must outlive tokens
+ *  @param lexer  - lexer
+ *  @param buffer - ini text
+ *  @param size   - text size
+ */
+void ini_lexer_init(ini_lexer* lexer, const char* buffer, size_t size);
+
+/**
+ *  @brief  reads next token, empty lines are skipped
+ *  @param  lexer - lexer
+ *  @param  token - token to fill
+ *  @retval       - false at the end of the buffer
+ */
+bool ini_lexer_next(ini_lexer* lexer, ini_token* token);
+
+/**
+ *  @brief  resolves escapes and line continuations of a raw value
+ *  @param  out   - output, may be the value itself (output never outruns input)
+ *  @param  value - raw value
+ *  @param  size  - raw value length
+ *  @retval       - length of the result without tailing spaces
+ */
+size_t ini_unescape(char* out, const char* value, size_t size);
+
+#pragma endregion
+
+#endif // !_INI_LEXER_H_
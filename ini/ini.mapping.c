@@ -0,0 +1,127 @@
+/*******************************************************************************
+ *  @file      ini.mapping.c
+ *  @brief     Read-only file mapping for the zero-copy loader
+ *  @author    Young Sideways
+ *  @date      17.10.2026
+ *  @copyright © Young Sideways, 2026. All right reserved.
+ ******************************************************************************/
+
+#include "ini.mapping.h"
+
+#pragma region --- INCLUDES ---
+
+#ifdef _WIN32
+#   define WIN32_LEAN_AND_MEAN
+#   include <windows.h>
+#else
+#   include <fcntl.h>
+#   include <unistd.h>
+#   include <sys/mman.h>
+#   include <sys/stat.h>
+#endif
+
+#pragma endregion
+
+#pragma region --- MACROS ---
+
+#define INI_MAPPING_EMPTY ((intptr_t)-1) //!< handle of an opened empty file (nothing is mapped)
+
+#pragma endregion
+
+#pragma region --- FUNCTIONS ---
+
+#ifdef _WIN32
+
+bool ini_mapping_open(ini_mapping* mapping, const char* path) {
+    mapping->data   = NULL;
+    mapping->size   = 0U;
+    mapping->handle = 0;
+
+    HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE)
+        return false;
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size) || (uint64_t)size.QuadPart > (uint64_t)SIZE_MAX)
+        goto _FAIL_SIZE;
+    if (size.QuadPart == 0) {
+        CloseHandle(file);
+        mapping->handle = INI_MAPPING_EMPTY;
+        return true;
+    }
+
+    // the view keeps the mapping object alive, so both handles are closed right away
+    HANDLE object = CreateFileMappingA(file, NULL, PAGE_WRITECOPY, 0, 0, NULL);
+    if (!object)
+        goto _FAIL_SIZE;
+    void* view = MapViewOfFile(object, FILE_MAP_COPY, 0, 0, 0);
+    CloseHandle(object);
+    if (!view)
+        goto _FAIL_SIZE;
+    CloseHandle(file);
+
+    mapping->data   = (char*)view;
+    mapping->size   = (size_t)size.QuadPart;
+    mapping->handle = (intptr_t)view;
+    return true;
+
+_FAIL_SIZE:
+    CloseHandle(file);
+    return false;
+}
+
+void ini_mapping_close(ini_mapping* mapping) {
+    if (mapping->data)
+        UnmapViewOfFile(mapping->data);
+    mapping->data   = NULL;
+    mapping->size   = 0U;
+    mapping->handle = 0;
+}
+
+#else
+
+bool ini_mapping_open(ini_mapping* mapping, const char* path) {
+    mapping->data   = NULL;
+    mapping->size   = 0U;
+    mapping->handle = 0;
+
+    int file = open(path, O_RDONLY);
+    if (file < 0)
+        return false;
+
+    struct stat info;
+    if (fstat(file, &info) != 0 || (uint64_t)info.st_size > (uint64_t)SIZE_MAX)
+        goto _FAIL_SIZE;
+    if (info.st_size == 0) {
+        close(file);
+        mapping->handle = INI_MAPPING_EMPTY;
+        return true;
+    }
+
+    // private writable mapping: modified pages are copied, the file stays untouched
+    void* view = mmap(NULL, (size_t)info.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, file, 0);
+    if (view == MAP_FAILED)
+        goto _FAIL_SIZE;
+    close(file);
+
+    mapping->data   = (char*)view;
+    mapping->size   = (size_t)info.st_size;
+    mapping->handle = (intptr_t)view;
+    return true;
+
+_FAIL_SIZE:
+    close(file);
+    return false;
+}
+
+void ini_mapping_close(ini_mapping* mapping) {
+    if (mapping->data)
+        munmap(mapping->data, mapping->size);
+    mapping->data   = NULL;
+    mapping->size   = 0U;
+    mapping->handle = 0;
+}
+
+#endif
+
+#pragma endregion
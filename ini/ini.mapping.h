@@ -0,0 +1,61 @@
+/*******************************************************************************
+ *  @file      ini.mapping.h
+ *  @brief     Read-only file mapping for the zero-copy loader
+ *  @author    Young Sideways
+ *  @date      17.10.2026
+ *  @copyright © Young Sideways, 2026. All right reserved.
+ ******************************************************************************/
+
+#ifndef _INI_MAPPING_H_
+#define _INI_MAPPING_H_
+
+#pragma once
+
+#pragma region --- INCLUDES ---
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#pragma endregion
+
+#pragma region --- TYPEDEFS ---
+
+typedef struct ini_mapping ini_mapping;
+
+#pragma endregion
+
+#pragma region --- STRUCTS ---
+
+/**
+ *  @brief private (copy-on-write) view of a whole file
+ *  @note  pages are mapped writable, but writes never reach the file:
+ *         the parser uses it to unescape values in place
+ */
+struct ini_mapping {
+    char* data;      //!< first byte of the view (NULL for an empty file)
+    size_t size;     //!< file size in bytes
+    intptr_t handle; //!< platform mapping handle (0 - not mapped)
+};
+
+#pragma endregion
+
+#pragma region --- FUNCTIONS ---
+
+/**
+ *  @brief  maps whole file into memory
+ *  @param  mapping - mapping to fill
+ *  @param  path    - path to the file
+ *  @retval         - true on success, mapping is zeroed on fail
+ */
+bool ini_mapping_open(ini_mapping* mapping, const char* path);
+
+/**
+ *  @brief unmaps file, all views into the mapping become invalid
+ *  @param mapping - mapping opened by ini_mapping_open (or zeroed)
+ */
+void ini_mapping_close(ini_mapping* mapping);
+
+#pragma endregion
+
+#endif // !_INI_MAPPING_H_
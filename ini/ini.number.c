@@ -0,0 +1,292 @@
+/*******************************************************************************
+ *  @file      ini.number.c
+ *  @brief     Locale independent number literals
+ *  @author    Young Sideways
+ *  @date      17.10.2026
+ *  @copyright © Young Sideways, 2026. All right reserved.
+ ******************************************************************************/
+
+#include "ini.number.h"
+
+#pragma region --- INCLUDES ---
+
+#include <errno.h>
+#include <locale.h>
+#include <math.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#pragma endregion
+
+#pragma region --- MACROS ---
+
+#define INI_MANTISSA_DIGITS 19                //!< decimal digits that always fit uint64_t
+#define INI_EXACT_MANTISSA  (1ULL << 53)      //!< largest mantissa exactly representable by double
+#define INI_EXACT_POW10     22                //!< largest power of ten exactly representable by double
+#define INI_EXPONENT_LIMIT  100000            //!< exponent digits after it don't change the result
+#define INI_SHORT_DIGITS    15                //!< digits of any decimal that survives double
+#define INI_EXACT_DIGITS    17                //!< digits that always round-trip a double
+
+#pragma endregion
+
+#pragma region --- INTERNAL ---
+
+static const double _pow10[INI_EXACT_POW10 + 1] = {
+    1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+/**
+ *  @brief  value of the digit in bases up to 16
+ *  @retval - 16 for a non digit
+ */
+static inline unsigned _digit(char ch) {
+    if (ch >= '0' && ch <= '9')
+        return (unsigned)(ch - '0');
+    ch |= 0x20;
+    if (ch >= 'a' && ch <= 'f')
+        return (unsigned)(ch - 'a') + 10U;
+    return 16U;
+}
+
+static inline bool _is_decimal(char ch) {
+    return ch >= '0' && ch <= '9';
+}
+
+/**
+ *  @brief decimal mantissa of a floating point literal
+ */
+typedef struct ini_decimal {
+    uint64_t mantissa; //!< first INI_MANTISSA_DIGITS significant digits
+    int digits;        //!< count of digits in the mantissa
+    int exponent;      //!< power of ten of the mantissa
+    bool truncated;    //!< some significant digits are dropped
+} ini_decimal;
+
+/**
+ *  @brief  appends digit to the mantissa
+ *  @param  fraction - digit is after the decimal point
+ */
+static inline void _decimal_push(ini_decimal* decimal, unsigned digit, bool fraction) {
+    if (decimal->digits < INI_MANTISSA_DIGITS) {
+        decimal->mantissa = decimal->mantissa * 10U + digit;
+        if (decimal->mantissa)
+            decimal->digits++;
+        if (fraction)
+            decimal->exponent--;
+    }
+    else {
+        decimal->truncated |= digit != 0U;
+        if (!fraction)
+            decimal->exponent++;
+    }
+}
+
+/**
+ *  @brief  exact conversion (Clinger's fast path): both the mantissa and
+ *          the power of ten are exact doubles, so a single rounding is done
+ *  @retval - false if the literal needs the slow path
+ */
+static bool _decimal_exact(const ini_decimal* decimal, double* value) {
+    if (decimal->truncated || decimal->mantissa > INI_EXACT_MANTISSA)
+        return false;
+    if (!decimal->mantissa) {
+        *value = 0.0;
+        return true;
+    }
+
+    int exponent = decimal->exponent;
+    if (exponent < -INI_EXACT_POW10)
+        return false;
+    if (exponent < 0) {
+        *value = (double)decimal->mantissa / _pow10[-exponent];
+        return true;
+    }
+
+    // "12e25" -> 12000e22, while the mantissa stays exact
+    uint64_t mantissa = decimal->mantissa;
+    for (; exponent > INI_EXACT_POW10; exponent--) {
+        if (mantissa > INI_EXACT_MANTISSA / 10U)
+            return false;
+        mantissa *= 10U;
+    }
+    *value = (double)mantissa * _pow10[exponent];
+    return true;
+}
+
+/**
+ *  @brief  correctly rounded conversion through strtod, with '.' swapped
+ *          for the decimal point of the current locale
+ *  @note   literals longer than INI_NUMBER_BUFFER_SIZE - 1 are copied to the heap
+ */
+static ini_number_status _decimal_slow(const char* str, size_t size, double* value) {
+    char local[INI_NUMBER_BUFFER_SIZE];
+    char* buffer = (size < sizeof(local)) ? local : malloc(size + 1U);
+    if (!buffer)
+        return INI_NUMBER_INVALID;
+    memcpy(buffer, str, size);
+    buffer[size] = '\0';
+
+    const char* point = localeconv()->decimal_point;
+    char* dot = memchr(buffer, '.', size);
+    if (dot && point && point[0] && !point[1])
+        *dot = point[0];
+
+    char* endptr = NULL;
+    errno = 0;
+    double result = strtod(buffer, &endptr);
+    ini_number_status status = INI_NUMBER_OK;
+    if (endptr != buffer + size)
+        status = INI_NUMBER_INVALID;
+    else if (errno == ERANGE && isinf(result))
+        status = INI_NUMBER_RANGE;
+    else
+        *value = result;
+
+    if (buffer != local)
+        free(buffer);
+    return status;
+}
+
+/**
+ *  @brief  swaps decimal point of the current locale for '.'
+ */
+static void _point_fix(char* buffer, size_t size) {
+    const char* point = localeconv()->decimal_point;
+    if (!point || !point[0] || (point[0] == '.' && !point[1]))
+        return;
+
+    char* found = strstr(buffer, point);
+    if (!found)
+        return;
+    size_t length = strlen(point);
+    *found = '.';
+    memmove(found + 1, found + length, size - (size_t)(found - buffer) - length + 1U);
+}
+
+#pragma endregion
+
+#pragma region --- FUNCTIONS ---
+
+ini_number_status ini_parse_int(const char* str, size_t size, int64_t* value) {
+    const char* end = str + size;
+    bool negative = false;
+    if (str < end && (*str == '+' || *str == '-'))
+        negative = *(str++) == '-';
+    if (str == end)
+        return INI_NUMBER_INVALID;
+
+    unsigned base = 10U;
+    if (*str == '0' && end - str > 1) {
+        base = 8U;
+        if ((str[1] | 0x20) == 'x') {
+            base = 16U;
+            if ((str += 2) == end)
+                return INI_NUMBER_INVALID;
+        }
+    }
+
+    // the whole literal is checked even after an overflow: "99999999999999999999x" isn't a number
+    uint64_t limit  = negative ? (uint64_t)INT64_MAX + 1U : (uint64_t)INT64_MAX;
+    uint64_t cutoff = limit / base;
+    unsigned cutlim = (unsigned)(limit % base);
+    uint64_t result = 0U;
+    bool overflow = false;
+    for (; str < end; str++) {
+        unsigned digit = _digit(*str);
+        if (digit >= base)
+            return INI_NUMBER_INVALID;
+        if (result > cutoff || (result == cutoff && digit > cutlim))
+            overflow = true;
+        else
+            result = result * base + digit;
+    }
+    if (overflow)
+        return INI_NUMBER_RANGE;
+
+    *value = (negative && result) ? -(int64_t)(result - 1U) - 1 : (int64_t)result;
+    return INI_NUMBER_OK;
+}
+
+ini_number_status ini_parse_double(const char* str, size_t size, double* value) {
+    const char* begin = str;
+    const char* end = str + size;
+    bool negative = false;
+    if (str < end && (*str == '+' || *str == '-'))
+        negative = *(str++) == '-';
+
+    ini_decimal decimal = { .mantissa = 0U, .digits = 0, .exponent = 0, .truncated = false };
+    bool digits = false;
+    for (; str < end && _is_decimal(*str); str++, digits = true)
+        _decimal_push(&decimal, (unsigned)(*str - '0'), false);
+    if (str < end && *str == '.')
+        for (str++; str < end && _is_decimal(*str); str++, digits = true)
+            _decimal_push(&decimal, (unsigned)(*str - '0'), true);
+    if (!digits)
+        return INI_NUMBER_INVALID;
+
+    if (str < end && (*str == 'e' || *str == 'E')) {
+        bool exponent_negative = false;
+        if (++str < end && (*str == '+' || *str == '-'))
+            exponent_negative = *(str++) == '-';
+        if (str == end || !_is_decimal(*str))
+            return INI_NUMBER_INVALID;
+
+        int exponent = 0;
+        for (; str < end && _is_decimal(*str); str++)
+            if (exponent < INI_EXPONENT_LIMIT)
+                exponent = exponent * 10 + (*str - '0');
+        decimal.exponent += exponent_negative ? -exponent : exponent;
+    }
+    if (str != end)
+        return INI_NUMBER_INVALID;
+
+    double result;
+    if (!_decimal_exact(&decimal, &result))
+        return _decimal_slow(begin, size, value);
+    *value = negative ? -result : result;
+    return INI_NUMBER_OK;
+}
+
+size_t ini_format_int(int64_t value, char* buffer) {
+    char digits[24];
+    char* str = digits + sizeof(digits);
+    uint64_t rest = (value < 0) ? 0U - (uint64_t)value : (uint64_t)value;
+    do {
+        *(--str) = (char)('0' + rest % 10U);
+        rest /= 10U;
+    } while (rest);
+    if (value < 0)
+        *(--str) = '-';
+
+    size_t length = (size_t)(digits + sizeof(digits) - str);
+    memcpy(buffer, str, length);
+    buffer[length] = '\0';
+    return length;
+}
+
+size_t ini_format_double(double value, char* buffer) {
+    // any decimal of up to 15 digits is recovered by "%.15g", so it is the shortest one
+    // for the most of values; the rest take 16 or 17 digits
+    size_t length = 0U;
+    for (int precision = INI_SHORT_DIGITS; precision <= INI_EXACT_DIGITS; precision++) {
+        length = (size_t)snprintf(buffer, INI_NUMBER_BUFFER_SIZE, "%.*g", precision, value);
+        _point_fix(buffer, length);
+        length = strlen(buffer);
+
+        double parsed;
+        if (!isfinite(value) || (ini_parse_double(buffer, length, &parsed) == INI_NUMBER_OK && parsed == value))
+            break;
+    }
+
+    // "1" would be read back as an integer
+    if (isfinite(value) && !strpbrk(buffer, ".e")) {
+        memcpy(buffer + length, ".0", sizeof(".0"));
+        length += sizeof(".0") - 1U;
+    }
+    return length;
+}
+
+#pragma endregion
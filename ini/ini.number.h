@@ -0,0 +1,85 @@
+/*******************************************************************************
+ *  @file      ini.number.h
+ *  @brief     Locale independent number literals
+ *  @author    Young Sideways
+ *  @date      17.10.2026
+ *  @copyright © Young Sideways, 2026. All right reserved.
+ ******************************************************************************/
+
+#ifndef _INI_NUMBER_H_
+#define _INI_NUMBER_H_
+
+#pragma once
+
+#pragma region --- INCLUDES ---
+
+#include <stddef.h>
+#include <stdint.h>
+
+#pragma endregion
+
+#pragma region --- MACROS ---
+
+#define INI_NUMBER_BUFFER_SIZE 64 //!< longest literal + 1 parsed outside the fast path on the stack, fits any formatted number
+
+#pragma endregion
+
+#pragma region --- TYPEDEFS ---
+
+typedef enum ini_number_status ini_number_status;
+
+#pragma endregion
+
+#pragma region --- ENUMS ---
+
+enum ini_number_status {
+    INI_NUMBER_INVALID, // not a literal of this type
+    INI_NUMBER_OK,      // value is parsed
+    INI_NUMBER_RANGE    // valid literal, the value doesn't fit the type
+};
+
+#pragma endregion
+
+#pragma region --- FUNCTIONS ---
+
+/**
+ *  @brief  parses integer literal: [+-] decimal, 0x hexadecimal or 0 octal digits
+ *  @param  str   - literal, not null-terminated
+ *  @param  size  - literal length, the whole span must be the literal
+ *  @param  value - parsed value, written only on INI_NUMBER_OK
+ *  @retval       - parse status
+ */
+ini_number_status ini_parse_int(const char* str, size_t size, int64_t* value);
+
+/**
+ *  @brief  parses decimal floating point literal: [+-] digits [. digits] [e [+-] digits]
+ *  @param  str   - literal, not null-terminated
+ *  @param  size  - literal length, the whole span must be the literal
+ *  @param  value - parsed value, written only on INI_NUMBER_OK
+ *  @retval       - parse status, INI_NUMBER_RANGE if the value overflows double
+ *  @note   the decimal point is always '.', whatever the locale is. Literals outside
+ *          the exact fast path longer than INI_NUMBER_BUFFER_SIZE - 1 take a heap copy
+ */
+ini_number_status ini_parse_double(const char* str, size_t size, double* value);
+
+/**
+ *  @brief  writes decimal integer
+ *  @param  value  - integer
+ *  @param  buffer - at least INI_NUMBER_BUFFER_SIZE bytes, the result is null-terminated
+ *  @retval        - length of the literal
+ */
+size_t ini_format_int(int64_t value, char* buffer);
+
+/**
+ *  @brief  writes the shortest of 15, 16 and 17 digit literals that is parsed back to the same double
+ *  @param  value  - double
+ *  @param  buffer - at least INI_NUMBER_BUFFER_SIZE bytes, the result is null-terminated
+ *  @retval        - length of the literal
+ *  @note   the decimal point is '.', a finite value always has '.' or an exponent,
+ *          so it is never read back as an integer
+ */
+size_t ini_format_double(double value, char* buffer);
+
+#pragma endregion
+
+#endif // !_INI_NUMBER_H_
@@ -7,6 +7,7 @@
  ******************************************************************************/
 
 #include "ini.parser.h"
+#include "ini.h"
 
  /*
 
@@ -65,313 +66,2173 @@
 #pragma region --- INCLUDES ---
 
 #include "ini.utils.h"
+#include "ini.lexer.h"
+#include "ini.number.h"
+#include "ini.thread.h"
 
 #pragma endregion
 
 #pragma region --- MACROS ---
 
-#define INI_COMMENT               "#;"
-
-#define INI_SECTION_OPEN_BRACKET  "["
-#define INI_SECTION_CLOSE_BRACKET "]"
 #define INI_DEFAULT_SECTION_NAME  "root"
 
-#define INI_PROPERTY_DELIMITER    "=:"
-
 #define INI_PARSER_BUFFER_SIZE    1024
+#define INI_DIAGNOSTIC_INIT_SIZE  8
+#define INI_REGION_INIT_SIZE      16
+#define INI_CHILDREN_INIT_SIZE    4
+#define INI_ENTRIES_INIT_SIZE     4
+#define INI_CHILDREN_KEYED_SORT   64          //!< longer lists are sorted by name prefix keys
+
+#define INI_PARALLEL_MIN_CHUNK    (64U << 10) //!< smaller chunks aren't worth a thread
+
+#define HASH_INIT            5381U
+#define HASH_STEP(hash, ch)  (33U * (hash) ^ (uint8_t)(ch))
 
-#define HT_INIT_SIZE         8U
-#define HT_SIZE_GROWTH(size) (((size) < 8U) ? 8U : ((size) << 1)) // x2 factor
-#define HT_MAX_LOAD_FACTOR   0.75f // 75%
+#define REGION_HASH_INIT     0x9E3779B97F4A7C15ULL
+#define REGION_HASH_MUL      0xFF51AFD7ED558CCDULL
 
 #pragma endregion
 
 #pragma region --- HASH ---
 
 static ini_hash default_hash(const void* data, size_t size) {
-    ini_hash hash = 5381U;
+    ini_hash hash = HASH_INIT;
     for (uint8_t* value = (uint8_t*)data; size; size--)
-        hash = 33U * hash ^ *(value++);
+        hash = HASH_STEP(hash, *(value++));
     return hash;
 }
 
-static ini_hash default_str_hash(const void* data, size_t size) {
-    UNUSED(size);
-
-    ini_hash hash = 5381U;
-    for (char* value = (char*)data; *value; value++)
-        hash = 33U * hash ^ (uint8_t) * (value++);
+/**
+ *  @brief  hashes full lowercase section name ("parent.name")
+ *  @param  parent - parent section, or NULL for a dotted name
+ *  @param  name   - section name (or its last part)
+ *  @param  size   - name length
+ *  @retval        - the same hash for "[settings] [.com1]" and "settings.com1"
+ */
+static ini_hash _section_hash(const ini_section* parent, const char* name, size_t size) {
+    ini_hash hash = parent ? HASH_STEP(parent->hash, '.') : HASH_INIT;
+    for (; size; size--)
+        hash = HASH_STEP(hash, tolower((uint8_t)*(name++)));
     return hash;
 }
 
+/**
+ *  @brief  64 bit hash of a text region, a word per step
+ *  @note   regions are told apart by it alone, so it is wider than ini_hash
+ */
+static uint64_t _region_hash(const char* data, size_t size) {
+    uint64_t hash = REGION_HASH_INIT ^ size;
+    for (; size >= sizeof(uint64_t); size -= sizeof(uint64_t), data += sizeof(uint64_t)) {
+        uint64_t word;
+        memcpy(&word, data, sizeof(uint64_t));
+        hash = (hash ^ word) * REGION_HASH_MUL;
+        hash ^= hash >> 32;
+    }
+    for (; size; size--)
+        hash = (hash ^ (uint8_t)*(data++)) * REGION_HASH_MUL;
+    return hash ^ (hash >> 29);
+}
+
 #pragma endregion
 
 #pragma region --- ERRORS ---
 
-static const char const* const ini_parse_errors[] = {
+const char* const ini_parse_errors[] = {
     "no error",
-    "error: null pointer access"
-    "error: memory allocation fail"
+    "error: null pointer access",
+    "error: memory allocation fail",
     "error: cannot open/create ini file. incorrect path or the necessary privileges are missing",
-    "error: bad ini syntax at %d row. invalid token",
-    "error: bad section/subsection syntax at %d row. leading trash",
-    "error: bad section/subsection syntax at %d row. tailing trash",
-    "error: bad section/subsection syntax at %d row. invalid section name."
-    "error: bad subsection syntax at %d row. too deep.",
-    "error: bad section/subsection syntax at %d row. unclosed bracket."
+    "error: bad ini syntax at %d row, %d column. invalid token",
+    "error: bad section/subsection syntax at %d row, %d column. leading trash",
+    "error: bad section/subsection syntax at %d row, %d column. tailing trash",
+    "error: bad section/subsection syntax at %d row, %d column. invalid section name.",
+    "error: bad subsection syntax at %d row, %d column. too deep.",
+    "error: bad section/subsection syntax at %d row, %d column. unclosed bracket.",
+    "error: bad ini syntax at %d row, %d column. line is too long",
+    "error: bad value at %d row, %d column. number out of range"
 };
 
-static struct ini_parse_error {
-    ini_parse_error_type type;
-    int row;
-} ini_parse_error = { .type = EINI_NO, .row = -1 };
+static void _diagnostics_reset(INI* file) {
+    file->diagnostic_count = 0U;
+    file->last_error       = EINI_NO;
+}
+
+/**
+ *  @brief  appends error to the diagnostics of the file
+ *  @retval - false if the list can't grow, the error is still kept as the last one
+ */
+static bool _diagnostic_push(INI* file, ini_parse_error_type type, int row, int column) {
+    file->last_error = type;
+    if (file->diagnostic_count == file->diagnostic_capacity) {
+        size_t capacity = file->diagnostic_capacity ? file->diagnostic_capacity * 2U : INI_DIAGNOSTIC_INIT_SIZE;
+        ini_diagnostic* diagnostics = ini_arena_alloc(&file->arena, capacity * sizeof(ini_diagnostic));
+        if (!diagnostics)
+            return false;
+        if (file->diagnostic_count)
+            memcpy(diagnostics, file->diagnostics, file->diagnostic_count * sizeof(ini_diagnostic));
+        file->diagnostics         = diagnostics;
+        file->diagnostic_capacity = capacity;
+    }
+    file->diagnostics[file->diagnostic_count++] = (ini_diagnostic){ .type = type, .row = row, .column = column };
+    return true;
+}
+
+#pragma endregion
+
+#pragma region --- POOL ---
+
+static bool _atom_match(const void* item, const void* key) {
+    const ini_atom* atom = item;
+    const ini_string* lookup = key;
+    return atom->string.length == lookup->length && memcmp(atom->string.data, lookup->data, lookup->length) == 0;
+}
+
+ini_atom* ini_atom_intern(INI* file, const char* data, size_t size, bool copy) {
+    ini_string lookup = { .data = data, .length = size };
+    ini_hash hash = default_hash(data, size);
+    ini_atom* atom = ini_table_find(&file->atoms, hash, _atom_match, &lookup);
+    if (atom)
+        return atom;
+
+    if (copy && !(data = ini_arena_strdup(&file->arena, data, size)))
+        return NULL;
+    ini_store_index index;
+    if (!(atom = ini_store_push(&file->atom_store, &file->arena, &index)))
+        return NULL;
+
+    // an atom left out of the table on fail is still a valid one, just never found
+    atom->string  = (ini_string){ .data = data, .length = size };
+    atom->hash    = hash;
+    atom->handle  = (ini_key_handle)index + 1U;
+    atom->section = NULL;
+    if (!ini_table_insert(&file->atoms, &file->arena, hash, index))
+        return NULL;
+    return atom;
+}
+
+const ini_atom* ini_atom_get(const INI* file, ini_key_handle handle) {
+    return (handle && handle <= file->atom_store.count) ? ini_store_at(&file->atom_store, handle - 1U) : NULL;
+}
 
 #pragma endregion
 
 #pragma region --- INTERNAL ---
 
+/**
+ *  @brief state of the streaming parser, kept between windows of a stream
+ */
+typedef struct ini_stream_state {
+    const ini_callbacks* callbacks; //!< events
+    void* user;                     //!< events argument
+    int row;                        //!< rows consumed before the current window
+    int token_row;                  //!< row of the token passed to the current event
+    int token_column;               //!< column of the token passed to the current event
+    uint8_t depth;                  //!< depth of the last valid section
+    bool stopped;                   //!< parsing stopped by a callback
+} ini_stream_state;
+
+/**
+ *  @brief parser state shared between line handlers
+ */
+typedef struct ini_parse_ctx {
+    INI* file;                               //!< destination
+    const ini_stream_state* stream;          //!< source of the current event, NULL - no text position
+    bool copy;                               //!< copy tokens (false - keep views into the buffer)
+    bool failed;                             //!< fatal error, parsing stopped
+
+    ini_section* section;                    //!< current section (NULL - skip properties)
+    ini_section* path[INI_MAX_DEPTH + 1];    //!< last valid section on each depth
+} ini_parse_ctx;
+
+/**
+ *  @brief fatal error not bound to the text (allocation fail), parsing stops
+ */
+static void _parse_error(ini_parse_ctx* ctx, ini_parse_error_type type) {
+    ctx->failed = true;
+    _diagnostic_push(ctx->file, type, -1, -1);
+}
+
+/**
+ *  @brief error of the current property value, parsing goes on
+ */
+static void _value_error(ini_parse_ctx* ctx, ini_parse_error_type type) {
+    int row    = ctx->stream ? ctx->stream->token_row : -1;
+    int column = ctx->stream ? ctx->stream->token_column : -1;
+    if (!_diagnostic_push(ctx->file, type, row, column))
+        ctx->failed = true;
+}
+
+/**
+ *  @brief  duplicates token, if parser works in copy mode
+ *  @param  ctx    - parser state
+ *  @param  token  - token
+ *  @param  size   - token length
+ *  @param  result - view or an owned null-terminated copy
+ *  @retval        - false on allocation fail
+ */
+static bool _token_store(ini_parse_ctx* ctx, const char* token, size_t size, ini_string* result) {
+    if (ctx->copy)
+        if (!(token = ini_arena_strdup(&ctx->file->arena, token, size)))
+            return false;
+    result->data   = token;
+    result->length = size;
+    return true;
+}
+
+/**
+ *  @brief section lookup key: either parent and own name, or full dotted name
+ */
+typedef struct ini_section_key {
+    const ini_section* parent; //!< enclosing section (unused for dotted names)
+    const char* name;          //!< name
+    size_t size;               //!< name length
+} ini_section_key;
+
+static bool _section_match(const void* item, const void* key) {
+    const ini_section* section = item;
+    const ini_section_key* lookup = key;
+    return section->parent == lookup->parent && section->name.length == lookup->size &&
+           mem_iequals(section->name.data, lookup->name, lookup->size);
+}
+
+static bool _section_match_dotted(const void* item, const void* key) {
+    const ini_section_key* lookup = key;
+    const char* name = lookup->name;
+    size_t left = lookup->size;
+
+    // compare dotted name from the tail: "settings.com1" -> "com1", "settings"
+    for (const ini_section* part = item; part; part = part->parent) {
+        if (part->name.length > left || !mem_iequals(name + left - part->name.length, part->name.data, part->name.length))
+            return false;
+        left -= part->name.length;
+        if (part->parent) {
+            if (left == 0U || name[left - 1] != '.')
+                return false;
+            left--;
+        }
+    }
+    return left == 0U;
+}
+
+static bool _property_match(const void* item, const void* key) {
+    const ini_property* property = item;
+    const ini_string* lookup = key;
+    return property->key.length == lookup->length && memcmp(property->key.data, lookup->data, lookup->length) == 0;
+}
+
+/**
+ *  @brief item identity, the key is the item itself
+ */
+static bool _same_item(const void* item, const void* key) {
+    return item == key;
+}
+
+/**
+ *  @brief  checks name of a section (part of a dotted name) or a key, as the lexer accepts them
+ *  @param  dots - '.' is allowed (keys)
+ */
+static bool _is_name(const char* name, size_t size, bool dots) {
+    if (!size)
+        return false;
+    for (; size; size--, name++)
+        if (!isalnum((uint8_t)*name) && *name != '_' && !(dots && *name == '.'))
+            return false;
+    return true;
+}
+
+static bool _property_match_handle(const void* item, const void* key) {
+    return ((const ini_property*)item)->handle == *(const ini_key_handle*)key;
+}
+
+/**
+ *  @brief  case insensitive order of section names
+ */
+static int _name_compare(const char* lhs, size_t lhs_size, const char* rhs, size_t rhs_size) {
+    size_t size = lhs_size < rhs_size ? lhs_size : rhs_size;
+    for (size_t i = 0; i < size; i++) {
+        int diff = tolower((uint8_t)lhs[i]) - tolower((uint8_t)rhs[i]);
+        if (diff)
+            return diff;
+    }
+    return (lhs_size > rhs_size) - (lhs_size < rhs_size);
+}
+
+static int _child_compare(const void* lhs, const void* rhs) {
+    const ini_section* left  = *(ini_section* const*)lhs;
+    const ini_section* right = *(ini_section* const*)rhs;
+    return _name_compare(left->name.data, left->name.length, right->name.data, right->name.length);
+}
+
+/**
+ *  @brief  order of a name, that starts with the prefix, is 0
+ */
+static int _prefix_compare(const ini_section* section, const char* prefix, size_t size) {
+    return _name_compare(section->name.data, section->name.length < size ? section->name.length : size, prefix, size);
+}
+
 /**
  *  @brief  allocates section block without binding to a parent ini file
- *  @param  name  - trimmed name
- *  @param  file  - ini file pointer
- *  @param  depth - valid section depth
+ *  @param  ctx    - parser state
+ *  @param  name   - trimmed name (without leading dots)
+ *  @param  size   - name length
+ *  @param  parent - enclosing section, NULL for depth 0
+ *  @param  depth  - valid section depth
+ *  @param  index  - index of the section in the store of the file
  *  @return builded section block, or NULL if error
  */
-ini_section * _section_alloc(const char* name, INI* file, uint8_t depth) {
-    ini_section* section = malloc(sizeof(ini_section));
-    if (!section)
-        goto _FAIL_SECTION;
-
-    size_t size = strlen(name);
-    if (!(section->name = malloc(size + 1)))
-        goto _FAIL_NAME;
-    if (!(section->properties = calloc(HT_INIT_SIZE, sizeof(ini_property*))))
-        goto _FAIL_PROPERTIES;
+static ini_section* _section_alloc(ini_parse_ctx* ctx, const char* name, size_t size, ini_section* parent, uint8_t depth,
+                                   ini_store_index* index) {
+    const ini_atom* atom = ini_atom_intern(ctx->file, name, size, ctx->copy);
+    ini_section* section = atom ? ini_store_push(&ctx->file->section_store, &ctx->file->arena, index) : NULL;
+    if (!section) {
+        _parse_error(ctx, EINI_MEMF);
+        return NULL;
+    }
 
-    memcpy(section->name, name, size + 1);
-    section->file = file;
-    section->hash = default_hash(name, size + 1);
-    section->depth = depth;
-    section->size = 0U;
-    section->capacity = HT_INIT_SIZE;
+    section->file   = ctx->file;
+    section->name   = atom->string;
+    section->parent = parent;
+    section->hash   = _section_hash(parent, name, size);
+    section->depth  = depth;
+    section->children = (ini_section_list){ .items = NULL, .count = 0U, .capacity = 0U, .sorted = true };
+    section->removed  = true;
+    section->entries  = (ini_entry_list){ .items = NULL, .count = 0U, .capacity = 0U, .removed = 0U };
+    ini_table_init(&section->properties, &ctx->file->property_store);
 
     return section;
+}
 
-_FAIL_PROPERTIES:
-    free(section->name);
-_FAIL_NAME:
-    free(section);
-_FAIL_SECTION:
-    ini_parse_error.type = EINI_MEMF;
-    ini_parse_error.row = -1;
-    return NULL;
+/**
+ *  @brief list of the section and its siblings in the section tree
+ */
+static ini_section_list* _section_siblings(ini_section* section) {
+    return section->parent ? &section->parent->children : &section->file->tree;
 }
 
-void _section_merge(ini_section* lhs, ini_section* rhs) {
+/**
+ *  @brief  appends section to the list, the list stays sorted while names come in order
+ *  @retval - false on allocation fail
+ */
+static bool _list_push(ini_arena* arena, ini_section_list* list, ini_section* section) {
+    if (list->count == list->capacity) {
+        size_t capacity = list->capacity ? list->capacity * 2U : INI_CHILDREN_INIT_SIZE;
+        ini_section** items = ini_arena_alloc(arena, capacity * sizeof(ini_section*));
+        if (!items)
+            return false;
+        if (list->count)
+            memcpy(items, list->items, list->count * sizeof(ini_section*));
+        list->items    = items;
+        list->capacity = capacity;
+    }
+    if (list->sorted && list->count && _child_compare(&list->items[list->count - 1U], &section) > 0)
+        list->sorted = false;
+    list->items[list->count++] = section;
+    return true;
+}
+
+/**
+ *  @brief removes section from the list, the last one is found at once
+ */
+static void _list_remove(ini_section_list* list, const ini_section* section) {
+    size_t index = list->count;
+    while (index && list->items[index - 1U] != section)
+        index--;
+    if (!index)
+        return;
+    memmove(&list->items[index - 1U], &list->items[index], (list->count - index) * sizeof(ini_section*));
+    list->count--;
+}
 
+/**
+ *  @brief section with first 8 lowercase bytes of its name, big endian
+ */
+typedef struct ini_sort_item {
+    uint64_t key;
+    ini_section* section;
+} ini_sort_item;
+
+static int _sort_item_compare(const void* lhs, const void* rhs) {
+    const ini_sort_item* left  = lhs;
+    const ini_sort_item* right = rhs;
+    if (left->key != right->key)
+        return (left->key < right->key) ? -1 : 1;
+    return _child_compare(&left->section, &right->section);
 }
 
 /**
- *  @brief binds section to a parent ini file
- *  @param section - valid section
+ *  @brief  sorts list changed since the last query
+ *  @note   a long list is sorted by keys kept next to the pointers, so most compares don't
+ *          touch the sections. The plain sort is used if the keys can't be allocated
  */
-static void _section_integrate(ini_section* section) {
-    if (section->file->sections[section->hash % section->file->capacity] != NULL) {
+static ini_section_list* _list_sorted(ini_section_list* list) {
+    if (list->sorted || list->count < 2U) {
+        list->sorted = true;
+        return list;
+    }
 
+    const ini_allocator* allocator = &list->items[0]->file->arena.allocator;
+    size_t size = list->count * sizeof(ini_sort_item);
+    ini_sort_item* keys = (list->count >= INI_CHILDREN_KEYED_SORT) ? allocator->alloc(size, allocator->user) : NULL;
+    if (!keys)
+        qsort(list->items, list->count, sizeof(ini_section*), _child_compare);
+    else {
+        for (size_t i = 0; i < list->count; i++) {
+            const ini_string name = list->items[i]->name;
+            uint64_t key = 0U;
+            for (size_t j = 0; j < sizeof(uint64_t); j++)
+                key = (key << 8) | (j < name.length ? (uint8_t)tolower((uint8_t)name.data[j]) : 0U);
+            keys[i] = (ini_sort_item){ .key = key, .section = list->items[i] };
+        }
+        qsort(keys, list->count, sizeof(ini_sort_item), _sort_item_compare);
+        for (size_t i = 0; i < list->count; i++)
+            list->items[i] = keys[i].section;
+        allocator->free(keys, size, allocator->user);
     }
+    list->sorted = true;
+    return list;
+}
+
+/**
+ *  @brief  binds section to a parent ini file
+ *  @param  section - valid section
+ *  @param  index   - index of the section in the store of the file
+ *  @retval         - false on allocation fail
+ */
+static bool _section_integrate(ini_section* section, ini_store_index index) {
+    INI* file = section->file;
+    file->frozen = NULL;
+    ini_section_list* siblings = _section_siblings(section);
+    if (!_list_push(&file->arena, siblings, section))
+        return false;
+    if (!ini_table_insert(&file->sections, &file->arena, section->hash, index)) {
+        siblings->count--;
+        return false;
+    }
+    section->removed = false;
+    return true;
+}
+
+/**
+ *  @brief unbinds section from the file, its memory stays in the arena (and in the store)
+ */
+static void _section_unlink(ini_section* section) {
+    INI* file = section->file;
+    file->frozen = NULL;
+    ini_table_remove(&file->sections, section->hash, _same_item, section);
+    _list_remove(_section_siblings(section), section);
+    section->removed = true;
 }
 
-ini_property* _property_alloc(const char* key, const ini_section* section) {
-    ini_property* property = malloc(sizeof(ini_property));
-    if (!property)
-        goto _FAIL_PROPERTY;
+/**
+ *  @brief  finds section or creates new one
+ *  @param  ctx    - parser state
+ *  @param  name   - section name (without parent prefix)
+ *  @param  size   - name length
+ *  @param  parent - enclosing section, NULL for depth 0
+ *  @param  depth  - valid section depth
+ *  @return section, or NULL if error
+ */
+static ini_section* _section_get(ini_parse_ctx* ctx, const char* name, size_t size, ini_section* parent, uint8_t depth) {
+    ini_section_key key = { .parent = parent, .name = name, .size = size };
+    ini_section* section = ini_table_find(&ctx->file->sections, _section_hash(parent, name, size), _section_match, &key);
+    if (section)
+        return section;
+
+    ini_store_index index;
+    section = _section_alloc(ctx, name, size, parent, depth, &index);
+    if (section && !_section_integrate(section, index)) {
+        _parse_error(ctx, EINI_MEMF);
+        section = NULL;
+    }
+    return section;
+}
 
-    size_t size = strlen(key);
-    if (!(property->key = malloc(size + 1)))
-        goto _FAIL_NAME;
+/**
+ *  @brief  allocates property block without binding to the section
+ *  @param  index - index of the property in the store of the section file
+ */
+static ini_property* _property_alloc(ini_parse_ctx* ctx, const ini_atom* key, ini_section* section, ini_store_index* index) {
+    ini_property* property = ini_store_push(&section->file->property_store, &section->file->arena, index);
+    if (!property) {
+        _parse_error(ctx, EINI_MEMF);
+        return NULL;
+    }
 
     property->section = section;
-    property->next = NULL;
-    memcpy(property->key, key, size + 1);
-    property->value.type = INI_NONE;
-    property->value.vdouble = 0.0;
+    property->key = key->string;
+    property->hash = key->hash;
+    property->handle = key->handle;
+    property->value = (ini_packed){ .type = INI_NONE };
+    property->binding = NULL;
+    property->removed = true;
 
     return property;
+}
 
-_FAIL_NAME:
-    free(property);
-_FAIL_PROPERTY:
-    ini_parse_error.type = EINI_MEMF;
-    ini_parse_error.row = -1;
-    return NULL;
+/**
+ *  @brief  appends property index to the list, indices of removed properties are dropped before the list grows
+ *  @param  file - file of the properties
+ *  @retval      - false on allocation fail
+ *  @note   removal itself never moves indices, so a walk may remove the properties it meets
+ */
+static bool _entries_push(INI* file, ini_entry_list* list, ini_store_index index) {
+    if (list->count == list->capacity && list->removed * 2U >= list->count) {
+        size_t count = 0U;
+        for (size_t i = 0; i < list->count; i++)
+            if (!((const ini_property*)ini_store_at(&file->property_store, list->items[i]))->removed)
+                list->items[count++] = list->items[i];
+        list->count   = count;
+        list->removed = 0U;
+    }
+    if (list->count == list->capacity) {
+        size_t capacity = list->capacity ? list->capacity * 2U : INI_ENTRIES_INIT_SIZE;
+        ini_store_index* items = ini_arena_alloc(&file->arena, capacity * sizeof(ini_store_index));
+        if (!items)
+            return false;
+        if (list->count)
+            memcpy(items, list->items, list->count * sizeof(ini_store_index));
+        list->items    = items;
+        list->capacity = capacity;
+    }
+    list->items[list->count++] = index;
+    return true;
+}
+
+/**
+ *  @brief  binds property to a parent section
+ *  @param  property - valid property
+ *  @param  index    - index of the property in the store of the section file
+ *  @retval          - false on allocation fail
+ */
+static bool _property_integrate(ini_property* property, ini_store_index index) {
+    ini_section* section = property->section;
+    INI* file = section->file;
+    file->frozen = NULL;
+    if (!_entries_push(file, &section->entries, index))
+        return false;
+    if (!ini_table_insert(&section->properties, &file->arena, property->hash, index)) {
+        section->entries.count--;
+        return false;
+    }
+    property->removed = false;
+    return true;
+}
+
+/**
+ *  @brief  moves properties of rhs into lhs, rhs values win
+ *  @param  lhs - destination section
+ *  @param  rhs - source section, its memory must be adopted by the lhs file
+ *  @retval     - false on allocation fail
+ */
+static bool _section_merge(ini_section* lhs, ini_section* rhs) {
+    ini_property_walk iter;
+    ini_property_walk_init(&iter, rhs->file, rhs);
+    for (ini_property* property; (property = ini_property_walk_next(&iter)); ) {
+        // handles belong to the pool of the partial file
+        const ini_atom* key = ini_atom_intern(lhs->file, property->key.data, property->key.length, false);
+        if (!key)
+            return false;
+        ini_property* found = ini_table_find(&lhs->properties, key->hash, _property_match_handle, &key->handle);
+        if (found) {
+            found->value = property->value;
+        }
+        else {
+            // the entry is copied to the store of lhs, so its walk stays linear
+            ini_store_index index;
+            ini_property* copy = ini_store_push(&lhs->file->property_store, &lhs->file->arena, &index);
+            if (!copy)
+                return false;
+            *copy = *property;
+            copy->section = lhs;
+            copy->key     = key->string;
+            copy->handle  = key->handle;
+            if (!_property_integrate(copy, index))
+                return false;
+        }
+    }
+    return true;
+}
+
+/**
+ *  @brief  finds (or creates) section of another file with the same full name
+ *  @param  ctx     - parser state of the destination file
+ *  @param  section - section of another file
+ *  @return section of the destination file, or NULL if error
+ */
+static ini_section* _section_resolve(ini_parse_ctx* ctx, const ini_section* section) {
+    ini_section* parent = NULL;
+    if (section->parent && !(parent = _section_resolve(ctx, section->parent)))
+        return NULL;
+    return _section_get(ctx, section->name.data, section->name.length, parent, section->depth);
+}
+
+/**
+ *  @brief  finds section of another file with the same full name
+ *  @param  file    - file to search
+ *  @param  section - section of another file
+ *  @return section of the file, or NULL if there is no such section
+ */
+static ini_section* _section_lookup(const INI* file, const ini_section* section) {
+    const ini_section* parent = NULL;
+    if (section->parent && !(parent = _section_lookup(file, section->parent)))
+        return NULL;
+    ini_section_key key = { .parent = parent, .name = section->name.data, .size = section->name.length };
+    return ini_table_find(&file->sections, section->hash, _section_match, &key);
+}
+
+static const ini_section* _section_top(const ini_section* section) {
+    while (section->parent)
+        section = section->parent;
+    return section;
+}
+
+/**
+ *  @brief  compares old value of the file with a reparsed one
+ *  @param  lhs - value of the file
+ *  @param  rhs - reparsed value, INI_RAW text is typed to compare with a typed lhs
+ */
+static bool _value_equals(const ini_value lhs, ini_value rhs) {
+    if (rhs.type == INI_RAW && lhs.type != INI_RAW)
+        rhs = ini_value_resolve(rhs);
+    if (lhs.type != rhs.type)
+        return false;
+
+    switch (lhs.type)
+    {
+    case INI_INT:
+        return lhs.vint == rhs.vint;
+    case INI_INT64:
+        return lhs.vint64 == rhs.vint64;
+    case INI_DOUBLE:
+        return memcmp(&lhs.vdouble, &rhs.vdouble, sizeof(double)) == 0;
+    case INI_BOOL:
+        return lhs.vbool == rhs.vbool;
+    case INI_STRING:
+    case INI_RAW:
+        return lhs.vstring.length == rhs.vstring.length &&
+               (!lhs.vstring.length || memcmp(lhs.vstring.data, rhs.vstring.data, lhs.vstring.length) == 0);
+    default:
+        return true;
+    }
+}
+
+/**
+ *  @brief  types number literal
+ *  @param  value - INI_INT, INI_INT64 or INI_DOUBLE value, written only on INI_NUMBER_OK
+ *  @retval       - INI_NUMBER_INVALID if the token isn't a number
+ */
+static ini_number_status _value_number(const char* token, size_t size, ini_value* value) {
+    int64_t int_value;
+    ini_number_status status = ini_parse_int(token, size, &int_value);
+    if (status == INI_NUMBER_OK) {
+        if (int_value >= INT_MIN && int_value <= INT_MAX)
+            *value = (ini_value){ .type = INI_INT, .vint = (int)int_value };
+        else
+            *value = (ini_value){ .type = INI_INT64, .vint64 = int_value };
+        return status;
+    }
+
+    double double_value;
+    if (status == INI_NUMBER_INVALID && (status = ini_parse_double(token, size, &double_value)) == INI_NUMBER_OK)
+        *value = (ini_value){ .type = INI_DOUBLE, .vdouble = double_value };
+    return status;
 }
 
-void _property_integrate(ini_property* property) {
+/**
+ *  @brief packs value, that isn't a string
+ */
+static void _packed_scalar(ini_packed* packed, const ini_value value) {
+    *packed = (ini_packed){ .type = (uint8_t)value.type };
+    switch (value.type)
+    {
+    case INI_INT:
+        packed->vint = value.vint;
+        break;
+    case INI_INT64:
+        packed->vint64 = value.vint64;
+        break;
+    case INI_DOUBLE:
+        packed->vdouble = value.vdouble;
+        break;
+    case INI_BOOL:
+        packed->vbool = value.vbool;
+        break;
+    default:
+        packed->type = INI_NONE;
+        break;
+    }
+}
 
+/**
+ *  @brief packs string up to INI_PACKED_INLINE characters, the text may be a view of the packed one
+ */
+static void _packed_inline(ini_packed* packed, ini_value_type type, const char* text, size_t size) {
+    char* inline_text = _ini_packed_text(packed);
+    if (size)
+        memmove(inline_text, text, size);
+    inline_text[size] = '\0';
+    packed->type = (uint8_t)type;
+    packed->size = (uint8_t)(size + 1U);
 }
 
 /**
- *  @brief parses token to ini typed value
+ *  @brief packs string kept outside
+ *  @param storage - log2 of the owned bytes, 0 - a view
+ */
+static void _packed_outer(ini_packed* packed, ini_value_type type, const char* text, size_t size, uint8_t storage) {
+    *packed = (ini_packed){ .type = (uint8_t)type, .size = 0U, .storage = storage, .length = (uint32_t)size };
+    packed->data = text;
+}
+
+/**
+ *  @brief parses token to ini typed value, lazy file keeps it as INI_RAW
+ *  @param ctx      - parser state
  *  @param property - valid property
- *  @param token    - valid trimmed token pointer
+ *  @param token    - valid trimmed and unescaped token
+ *  @param size     - token length
+ *  @note  short strings are copied into the property even if tokens are views,
+ *         storage of a redefined value isn't reused
  */
-void _property_parse_value_token(ini_property* property, const char* token) {
-    size_t size = strlen(token);
+static void _property_parse_value_token(ini_parse_ctx* ctx, ini_property* property, const char* token, size_t size) {
+    ini_value number;
+    ini_string text;
+    ini_value_type type = ctx->file->lazy ? INI_RAW : INI_STRING;
     if (size == 0)
         goto _SET_DEFAULT;
 
-    char* endptr = NULL;
+    if (!ctx->file->lazy)
+        switch (_value_number(token, size, &number))
+        {
+        case INI_NUMBER_OK:
+            _packed_scalar(&property->value, number);
+            return;
+        case INI_NUMBER_RANGE:
+            goto _OUT_OF_RANGE;
+        default:
+            break;
+        }
 
-    int int_value = strtol(token, &endptr, 0);
-    if (*endptr == '\0') {
-        property->value.type = INI_INT;
-        property->value.vint = int_value;
-        return;
-    }
-    double double_value = strtod(token, endptr);
-    if (*endptr == '\0') {
-        property->value.type = INI_DOUBLE;
-        property->value.vint = double_value;
+    if (size <= INI_PACKED_INLINE) {
+        _packed_inline(&property->value, type, token, size);
         return;
     }
-    if (!(property->value.vstring = malloc(size + 1)))
+    if (size > UINT32_MAX)
+        goto _TOO_LONG;
+    if (!_token_store(ctx, token, size, &text))
         goto _FAIL_STRING;
-    property->value.type = INI_STRING;
-    memcpy(property->value.vstring, token, size + 1);
-
+    // a copied token owns size + 1 bytes, so a text shorter than the power of two below fits it
+    _packed_outer(&property->value, type, text.data, size, ctx->copy ? (uint8_t)bit_msb32((uint32_t)size) : 0U);
     return;
 
 _SET_DEFAULT:
-    property->value.type = INI_INT;
-    property->value.vint = 0;
+    _packed_scalar(&property->value, (ini_value){ .type = INI_INT, .vint = 0 });
+    return;
+_OUT_OF_RANGE:
+    _value_error(ctx, EINI_RANGE);
+    property->value = (ini_packed){ .type = INI_NONE };
+    return;
+_TOO_LONG:
+    _value_error(ctx, EINI_TOOLNG);
+    property->value = (ini_packed){ .type = INI_NONE };
     return;
 _FAIL_STRING:
-    ini_parse_error.type = EINI_MEMF;
-    ini_parse_error.row = -1;
-    property->value.type = INI_NONE;
-    property->value.vdouble = 0.0;
+    _parse_error(ctx, EINI_MEMF);
+    property->value = (ini_packed){ .type = INI_NONE };
+}
+
+/**
+ *  @brief  generates "root" section, properties before the first declaration belong to it
+ *  @retval - false on allocation fail
+ */
+static bool _build_root(ini_parse_ctx* ctx) {
+    ctx->section = _section_get(ctx, INI_DEFAULT_SECTION_NAME, sizeof(INI_DEFAULT_SECTION_NAME) - 1, NULL, 0U);
+    ctx->path[0] = ctx->section;
+    return ctx->section != NULL;
+}
+
+/**
+ *  @brief binds section declaration, see ini_callbacks::on_section
+ */
+static bool _build_section(const ini_string* name, uint8_t depth, void* user) {
+    ini_parse_ctx* ctx = user;
+
+    // "[]" - back to the root section
+    ini_string full = name->length ? *name : (ini_string){ INI_DEFAULT_SECTION_NAME, sizeof(INI_DEFAULT_SECTION_NAME) - 1 };
+    ctx->section = _section_get(ctx, full.data, full.length, depth ? ctx->path[depth - 1] : NULL, depth);
+    if (ctx->section)
+        ctx->path[depth] = ctx->section;
+    return !ctx->failed;
+}
+
+/**
+ *  @brief binds property to the current section, see ini_callbacks::on_property
+ */
+static bool _build_property(const ini_string* key, const ini_string* value, void* user) {
+    ini_parse_ctx* ctx = user;
+    if (!ctx->section)
+        return true;
+
+    ini_section* section = ctx->section;
+    const ini_atom* atom = ini_atom_intern(ctx->file, key->data, key->length, ctx->copy);
+    if (!atom) {
+        _parse_error(ctx, EINI_MEMF);
+        return false;
+    }
+    ini_property* property = ini_table_find(&section->properties, atom->hash, _property_match_handle, &atom->handle);
+
+    // redefinition - the last value wins
+    if (!property) {
+        ini_store_index index;
+        if (!(property = _property_alloc(ctx, atom, section, &index)))
+            return false;
+        if (!_property_integrate(property, index)) {
+            _parse_error(ctx, EINI_MEMF);
+            return false;
+        }
+    }
+    _property_parse_value_token(ctx, property, value->data, value->length);
+    return !ctx->failed;
+}
+
+/**
+ *  @brief collects syntax error, see ini_callbacks::on_error
+ */
+static bool _build_error(ini_parse_error_type type, int row, int column, void* user) {
+    ini_parse_ctx* ctx = user;
+    if (!_diagnostic_push(ctx->file, type, row, column))
+        ctx->failed = true;
+
+    // properties after a broken declaration are skipped
+    if (type == EINI_TLTRSH || type == EINI_INSEC || type == EINI_TOODP || type == EINI_UNBRCK)
+        ctx->section = NULL;
+    return !ctx->failed;
+}
+
+static const ini_callbacks _builder = {
+    .on_section  = _build_section,
+    .on_property = _build_property,
+    .on_error    = _build_error
+};
+
+/**
+ *  @brief keys of a frozen table under construction (allocator memory)
+ */
+typedef struct ini_freeze_ctx {
+    INI* file;
+    uint64_t* keys;           //!< keys of the table
+    ini_store_index* indices; //!< store index of every key
+    size_t capacity;          //!< allocated keys and indices
+    char* name;               //!< full name of the current section
+    size_t name_capacity;     //!< allocated name
+} ini_freeze_ctx;
+
+/**
+ *  @brief  key of the full section name, as ini_find_section hashes it
+ *  @retval - false on allocation fail
+ */
+static bool _frozen_section_key(ini_freeze_ctx* ctx, const ini_section* section, uint64_t* key) {
+    const ini_allocator* allocator = &ctx->file->arena.allocator;
+    size_t length = ini_section_name_length(section);
+    if (length > ctx->name_capacity) {
+        size_t capacity = length > 2U * ctx->name_capacity ? length : 2U * ctx->name_capacity;
+        char* name = allocator->alloc(capacity, allocator->user);
+        if (!name)
+            return false;
+        if (ctx->name)
+            allocator->free(ctx->name, ctx->name_capacity, allocator->user);
+        ctx->name          = name;
+        ctx->name_capacity = capacity;
+    }
+    ini_section_name_write(ctx->name, section);
+    *key = ini_phash_key(ctx->name, length, true);
+    return true;
+}
+
+/**
+ *  @brief  builds frozen table of the collected keys
+ *  @param  slots - store index of every slot (in the arena)
+ *  @retval       - false on allocation fail or equal keys
+ */
+static bool _frozen_build(ini_freeze_ctx* ctx, uint32_t count, ini_phash* phash, ini_store_index** slots) {
+    INI* file = ctx->file;
+    phash->count = 0U;
+    *slots = NULL;
+    if (!count)
+        return true;
+
+    if (!ini_phash_build(phash, ctx->keys, count, &file->arena) ||
+        !(*slots = ini_arena_alloc(&file->arena, (size_t)count * sizeof(ini_store_index))))
+        return false;
+    for (uint32_t i = 0; i < count; i++)
+        (*slots)[ini_phash_slot(phash, ctx->keys[i])] = ctx->indices[i];
+    return true;
+}
+
+/**
+ *  @brief  builds frozen tables of every bound section and property
+ *  @retval - false on allocation fail or equal keys
+ */
+static bool _frozen_fill(ini_freeze_ctx* ctx, ini_frozen* frozen) {
+    const INI* file = ctx->file;
+    uint32_t count = 0U;
+    for (ini_store_index index = 0; index < file->section_store.count; index++) {
+        const ini_section* section = ini_store_at(&file->section_store, index);
+        if (section->removed)
+            continue;
+        if (!_frozen_section_key(ctx, section, &ctx->keys[count]))
+            return false;
+        ctx->indices[count++] = index;
+    }
+    if (!_frozen_build(ctx, count, &frozen->sections, &frozen->section_slots))
+        return false;
+
+    count = 0U;
+    for (ini_store_index index = 0; index < file->section_store.count; index++) {
+        const ini_section* section = ini_store_at(&file->section_store, index);
+        uint64_t name;
+        if (section->removed)
+            continue;
+        if (!_frozen_section_key(ctx, section, &name))
+            return false;
+        for (size_t i = 0; i < section->entries.count; i++) {
+            const ini_property* property = ini_store_at(&file->property_store, section->entries.items[i]);
+            if (property->removed)
+                continue;
+            ctx->keys[count]      = ini_phash_pair(name, ini_phash_key(property->key.data, property->key.length, false));
+            ctx->indices[count++] = section->entries.items[i];
+        }
+    }
+    return _frozen_build(ctx, count, &frozen->properties, &frozen->property_slots);
+}
+
+/**
+ *  @brief queries of ini_lookup_properties with measured names
+ */
+typedef struct ini_lookup_batch {
+    const ini_query* queries;
+    size_t count;
+    const char* sections[INI_LOOKUP_BATCH];  //!< section names, "root" for NULL
+    size_t section_sizes[INI_LOOKUP_BATCH];  //!< section name lengths
+    size_t key_sizes[INI_LOOKUP_BATCH];      //!< key lengths
+} ini_lookup_batch;
+
+/**
+ *  @brief lookup in the frozen tables: pilot, slot, property, then its names are read a pass each
+ */
+static void _lookup_frozen(const INI* ini, const ini_lookup_batch* batch, ini_property** out) {
+    const ini_frozen* frozen = ini->frozen;
+    const ini_phash* phash = &frozen->properties;
+    uint64_t hashes[INI_LOOKUP_BATCH];
+    uint32_t slots[INI_LOOKUP_BATCH];
+    if (!phash->count) {
+        memset(out, 0, batch->count * sizeof(ini_property*));
+        return;
+    }
+
+    for (size_t i = 0; i < batch->count; i++) {
+        const char* key = batch->queries[i].key ? batch->queries[i].key : "";
+        uint64_t pair = ini_phash_pair(ini_phash_key(batch->sections[i], batch->section_sizes[i], true),
+                                       ini_phash_key(key, batch->key_sizes[i], false));
+        hashes[i] = ini_phash_mixed(phash, pair);
+        mem_prefetch(ini_phash_pilot(phash, hashes[i]));
+    }
+    for (size_t i = 0; i < batch->count; i++) {
+        slots[i] = ini_phash_mixed_slot(phash, hashes[i]);
+        mem_prefetch(&frozen->property_slots[slots[i]]);
+    }
+    for (size_t i = 0; i < batch->count; i++) {
+        out[i] = ini_store_at(&ini->property_store, frozen->property_slots[slots[i]]);
+        mem_prefetch(out[i]);
+    }
+    for (size_t i = 0; i < batch->count; i++) {
+        mem_prefetch(out[i]->key.data);
+        mem_prefetch(out[i]->section);
+    }
+
+    // a name out of the file gets some property too
+    for (size_t i = 0; i < batch->count; i++) {
+        const ini_property* property = out[i];
+        ini_section_key lookup = { .parent = NULL, .name = batch->sections[i], .size = batch->section_sizes[i] };
+        if (!batch->queries[i].key || property->key.length != batch->key_sizes[i] ||
+            memcmp(property->key.data, batch->queries[i].key, batch->key_sizes[i]) ||
+            !_section_match_dotted(property->section, &lookup))
+            out[i] = NULL;
+    }
+}
+
+/**
+ *  @brief lookup in the hash tables: section groups, sections with their property groups, then properties
+ */
+static void _lookup_tables(const INI* ini, const ini_lookup_batch* batch, ini_property** out) {
+    ini_hash hashes[INI_LOOKUP_BATCH];
+    const ini_section* sections[INI_LOOKUP_BATCH];
+    for (size_t i = 0; i < batch->count; i++) {
+        hashes[i] = _section_hash(NULL, batch->sections[i], batch->section_sizes[i]);
+        ini_table_prefetch(&ini->sections, hashes[i]);
+    }
+    for (size_t i = 0; i < batch->count; i++) {
+        ini_section_key key = { .parent = NULL, .name = batch->sections[i], .size = batch->section_sizes[i] };
+        sections[i] = batch->queries[i].key ? ini_table_find(&ini->sections, hashes[i], _section_match_dotted, &key) : NULL;
+        if (sections[i]) {
+            hashes[i] = default_hash(batch->queries[i].key, batch->key_sizes[i]);
+            ini_table_prefetch(&sections[i]->properties, hashes[i]);
+        }
+    }
+    for (size_t i = 0; i < batch->count; i++) {
+        ini_string lookup = { .data = batch->queries[i].key, .length = batch->key_sizes[i] };
+        out[i] = sections[i] ? ini_table_find(&sections[i]->properties, hashes[i], _property_match, &lookup) : NULL;
+    }
 }
 
 #pragma endregion
 
 #pragma region --- FUNCTIONS ---
 
-void ini_tokenize(INI* ini) {
-    ini_parse_error.type = EINI_NO;
-    ini_parse_error.row  = -1;
+static void _emit_error(ini_stream_state* state, ini_parse_error_type type, int row, int column) {
+    if (state->callbacks->on_error && !state->callbacks->on_error(type, (row >= 0) ? state->row + row : -1, column, state->user))
+        state->stopped = true;
+}
 
-    FILE* file = fopen(ini->path, "r+");
-    if (!file) {
-        ini_parse_error.type = EINI_OCF;
-        ini_parse_error.row = -1;
+/**
+ *  @brief  lexes window of complete lines and fires events
+ *  @param  state  - parser state
+ *  @param  buffer - writable ini text
+ *  @param  size   - text size
+ *  @retval        - count of consumed rows
+ */
+static int _parse_window(ini_stream_state* state, char* buffer, size_t size) {
+    const ini_callbacks* callbacks = state->callbacks;
+
+    ini_lexer lexer;
+    ini_token token;
+    ini_lexer_init(&lexer, buffer, size);
+    while (!state->stopped && ini_lexer_next(&lexer, &token)) {
+        state->token_row    = state->row + token.row;
+        state->token_column = token.column;
+        switch (token.type)
+        {
+        case INI_TOKEN_SECTION:
+            if (token.depth > state->depth + 1U) {
+                _emit_error(state, EINI_TOODP, token.row, token.column);
+                break;
+            }
+            state->depth = token.depth;
+            if (callbacks->on_section && !callbacks->on_section(&token.name, token.depth, state->user))
+                state->stopped = true;
+            break;
+        case INI_TOKEN_PROPERTY:
+            if (token.escaped)
+                token.value.length = ini_unescape((char*)token.value.data, token.value.data, token.value.length);
+            if (callbacks->on_property && !callbacks->on_property(&token.name, &token.value, state->user))
+                state->stopped = true;
+            break;
+        case INI_TOKEN_ERROR:
+            _emit_error(state, token.error, token.row, token.column);
+            break;
+        default:
+            break;
+        }
+    }
+    return lexer.row;
+}
+
+/**
+ *  @brief  checks that the line isn't continued on the next one
+ *  @param  begin - start of the buffer
+ *  @param  eol   - line feed of the line
+ *  @retval       - false if the line ends with an unpaired backslash
+ *  @note   a backslash in a comment is counted as well, such a line is just kept for the next window
+ */
+static bool _is_line_end(const char* begin, const char* eol) {
+    while (eol > begin && eol[-1] != '\n' && isspace((uint8_t)eol[-1]))
+        eol--;
+    size_t slashes = 0U;
+    while (eol > begin && eol[-1] == '\\') {
+        eol--;
+        slashes++;
+    }
+    return !(slashes & 1U);
+}
+
+/**
+ *  @brief  size of the complete lines at the start of the buffer
+ *  @param  from - bytes before it are known to hold no line end
+ *  @retval - 0 if even the first line isn't complete
+ */
+static size_t _complete_lines(const char* buffer, size_t from, size_t size) {
+    size_t lines = 0U;
+    for (const char* eol = buffer + from; (eol = memchr(eol, '\n', (size_t)(buffer + size - eol))); eol++)
+        if (_is_line_end(buffer, eol))
+            lines = (size_t)(eol - buffer) + 1U;
+    return lines;
+}
+
+/**
+ *  @brief  size of the first complete line
+ *  @retval - 0 if the line isn't complete
+ */
+static size_t _first_line(const char* buffer, size_t size) {
+    for (const char* eol = buffer; (eol = memchr(eol, '\n', (size_t)(buffer + size - eol))); eol++)
+        if (_is_line_end(buffer, eol))
+            return (size_t)(eol - buffer) + 1U;
+    return 0U;
+}
+
+static int _count_rows(const char* buffer, size_t size) {
+    int rows = 0;
+    for (const char* eol = buffer; (eol = memchr(eol, '\n', (size_t)(buffer + size - eol))); eol++)
+        rows++;
+    return rows;
+}
+
+/**
+ *  @brief  builds ini file from memory block
+ *  @param  ctx    - parser state
+ *  @param  buffer - writable ini text
+ *  @param  size   - text size
+ *  @param  row    - rows of the text before the block
+ *  @retval        - count of consumed rows
+ */
+static int _tokenize(ini_parse_ctx* ctx, char* buffer, size_t size, int row) {
+    if (!_build_root(ctx))
+        return 0;
+
+    ini_stream_state state = { .callbacks = &_builder, .user = ctx, .row = row, .depth = 0U, .stopped = false };
+    ctx->stream = &state;
+    int rows = _parse_window(&state, buffer, size);
+    ctx->stream = NULL;
+    return rows;
+}
+
+/**
+ *  @brief  checks that the line starts a valid top level section
+ *  @param  begin - start of the buffer
+ *  @param  line  - line start
+ *  @param  end   - end of the buffer
+ *  @retval       - true if a chunk may start here: relative subsections below
+ *                  it never refer to anything above
+ */
+static bool _is_chunk_start(const char* begin, const char* line, const char* end) {
+    const char* eol = memchr(line, '\n', (size_t)(end - line));
+    eol = eol ? eol : end;
+
+    const char* str = line;
+    while (str < eol && isspace((uint8_t)*str))
+        str++;
+    // "[.name]" is a subsection (or broken) whatever follows
+    if (str == eol || *str != '[' || (str + 1 < eol && str[1] == '.'))
+        return false;
+
+    // the previous line must not be continued into this one
+    if (line > begin) {
+        const char* prev = line - 1;
+        while (prev > begin && prev[-1] != '\n' && isspace((uint8_t)prev[-1]))
+            prev--;
+        if (prev > begin && prev[-1] == '\\')
+            return false;
+    }
+
+    ini_lexer lexer;
+    ini_token token;
+    ini_lexer_init(&lexer, str, (size_t)(eol - str));
+    return ini_lexer_next(&lexer, &token) && token.type == INI_TOKEN_SECTION && token.depth == 0U;
+}
+
+/**
+ *  @brief  finds the first chunk start at or after from
+ *  @retval - chunk start, or end of the buffer
+ */
+static char* _next_chunk_start(const char* begin, char* from, char* end) {
+    // brackets are rare in values, so they are searched instead of walking every line
+    for (char* bracket = from; bracket < end && (bracket = memchr(bracket, '[', (size_t)(end - bracket))); bracket++) {
+        char* line = bracket;
+        while (line > begin && line[-1] != '\n' && isspace((uint8_t)line[-1]))
+            line--;
+        if (line >= from && (line == begin || line[-1] == '\n') && _is_chunk_start(begin, line, end))
+            return line;
+    }
+    return end;
+}
+
+/**
+ *  @brief part of the buffer parsed by its own thread into its own file
+ */
+typedef struct ini_chunk {
+    ini_parse_ctx ctx; //!< parser state, ctx.file is a partial file (or the destination for the first chunk)
+    char* data;        //!< chunk start
+    size_t size;       //!< chunk size
+    int rows;          //!< consumed rows
+    ini_thread thread; //!< worker
+    bool started;      //!< worker is running
+} ini_chunk;
+
+static void _chunk_routine(void* arg) {
+    ini_chunk* chunk = arg;
+    chunk->rows = _tokenize(&chunk->ctx, chunk->data, chunk->size, 0);
+}
+
+void ini_tokenize_buffer(INI* ini, char* buffer, size_t size, bool copy) {
+    ini_parse_ctx ctx = { .file = ini, .copy = copy, .failed = false };
+    _diagnostics_reset(ini);
+    _tokenize(&ctx, buffer, size, 0);
+}
+
+void ini_tokenize_parallel(INI* ini, char* buffer, size_t size, unsigned threads) {
+    if (!threads)
+        threads = ini_thread_concurrency();
+    size_t count = size / INI_PARALLEL_MIN_CHUNK;
+    if (count > threads)
+        count = threads;
+    if (count <= 1U) {
+        ini_tokenize_buffer(ini, buffer, size, false);
         return;
     }
 
-    if (!(ini->sections = calloc(HT_INIT_SIZE, sizeof(ini_section*)))) {
-        ini_parse_error.type = EINI_MEMF;
-        ini_parse_error.row = -1;
+    _diagnostics_reset(ini);
+    const ini_allocator* allocator = &ini->arena.allocator;
+    ini_chunk* chunks = allocator->alloc(count * sizeof(ini_chunk), allocator->user);
+    if (!chunks) {
+        _diagnostic_push(ini, EINI_MEMF, -1, -1);
         return;
     }
-    ini->capacity = HT_INIT_SIZE;
 
-    ini_section* current_section = NULL;
+    // split at top level sections: every chunk resolves its relative subsections by itself
+    char* end = buffer + size;
+    size_t used = 0U;
+    for (char* start = buffer; start < end && used < count; used++) {
+        char* stop = end;
+        if (used + 1U < count) {
+            char* target = buffer + size / count * (used + 1U);
+            stop = _next_chunk_start(buffer, (target > start) ? target : start + 1, end);
+        }
 
-    // generate "root" section
-    if (!(current_section = _section_alloc(SECTION_NAME, ini, 0)))
-        return;
+        ini_chunk* chunk = &chunks[used];
+        memset(chunk, 0, sizeof(ini_chunk));
+        chunk->ctx.file = used ? ini_create(allocator) : ini;
+        chunk->ctx.failed = !chunk->ctx.file;
+        if (chunk->ctx.file)
+            chunk->ctx.file->lazy = ini->lazy;
+        chunk->data     = start;
+        chunk->size     = (size_t)(stop - start);
+        start = stop;
+    }
+
+    for (size_t i = 1; i < used; i++)
+        if (!chunks[i].ctx.failed)
+            chunks[i].started = ini_thread_start(&chunks[i].thread, _chunk_routine, &chunks[i]);
+    _chunk_routine(&chunks[0]);
+
+    // chunks are merged in file order, so later redefinitions still win
+    // and diagnostics stay sorted, with rows counted from the start of the file
+    ini_parse_ctx merge = { .file = ini, .copy = false, .failed = chunks[0].ctx.failed };
+    int row = chunks[0].rows;
+    for (size_t i = 1; i < used; i++) {
+        ini_chunk* chunk = &chunks[i];
+        if (chunk->started)
+            ini_thread_join(&chunk->thread);
+        else if (!chunk->ctx.failed)
+            _chunk_routine(chunk);
+
+        INI* partial = chunk->ctx.file;
+        if (!partial) {
+            _parse_error(&merge, EINI_MEMF);
+            continue;
+        }
+        ini_section_walk iter;
+        ini_section_walk_init(&iter, partial);
+        for (ini_section* section; !merge.failed && (section = ini_section_walk_next(&iter)); ) {
+            ini_section* target = _section_resolve(&merge, section);
+            if (!target || !_section_merge(target, section))
+                _parse_error(&merge, EINI_MEMF);
+        }
+        for (size_t j = 0; j < partial->diagnostic_count; j++) {
+            ini_diagnostic diagnostic = partial->diagnostics[j];
+            _diagnostic_push(ini, diagnostic.type, (diagnostic.row >= 0) ? diagnostic.row + row : -1, diagnostic.column);
+        }
+        if (partial->last_error != EINI_NO)
+            ini->last_error = partial->last_error;
+        row += chunk->rows;
+
+        ini_arena_adopt(&ini->arena, &partial->arena);
+        ini_destroy(partial);
+    }
+
+    allocator->free(chunks, count * sizeof(ini_chunk), allocator->user);
+}
+
+/**
+ *  @brief top level declaration of the text with everything up to the next one
+ */
+typedef struct ini_text_region {
+    char* data;           //!< region start
+    size_t size;          //!< region size
+    ini_string name;      //!< declared section name ("root" for the first region)
+    ini_section* section; //!< declared section of the file, NULL - the file doesn't have it yet
+    uint64_t hash;        //!< hash of the text
+} ini_text_region;
+
+/**
+ *  @brief region hash of a section group
+ */
+typedef struct ini_region_key {
+    const ini_section* section; //!< group
+    uint64_t hash;              //!< region hash, hash of the whole group after _group_regions
+    size_t index;               //!< region order in the text
+} ini_region_key;
+
+/**
+ *  @brief  name of the section declared by the first line of a region
+ */
+static ini_string _region_name(const char* data, size_t size) {
+    const char* eol = memchr(data, '\n', size);
+    eol = eol ? eol : data + size;
+    while (data < eol && isspace((uint8_t)*data))
+        data++;
+
+    ini_lexer lexer;
+    ini_token token;
+    ini_lexer_init(&lexer, data, (size_t)(eol - data));
+    if (!ini_lexer_next(&lexer, &token) || token.type != INI_TOKEN_SECTION || !token.name.length)
+        return (ini_string){ INI_DEFAULT_SECTION_NAME, sizeof(INI_DEFAULT_SECTION_NAME) - 1 };
+    return token.name;
+}
+
+/**
+ *  @brief  splits text at top level sections, the first region is the text before the first one
+ *  @param  count    - count of regions
+ *  @param  capacity - allocated regions
+ *  @retval          - regions (allocator memory), or NULL on allocation fail
+ */
+static ini_text_region* _split_regions(const ini_allocator* allocator, char* buffer, size_t size, size_t* count, size_t* capacity) {
+    *capacity = INI_REGION_INIT_SIZE;
+    ini_text_region* regions = allocator->alloc(*capacity * sizeof(ini_text_region), allocator->user);
+    if (!regions)
+        return NULL;
+
+    char* end = buffer + size;
+    *count = 0U;
+    for (char* start = buffer; ; ) {
+        char* stop = _next_chunk_start(buffer, *count ? start + 1 : start, end);
+        if (*count == *capacity) {
+            ini_text_region* grown = allocator->alloc(*capacity * 2U * sizeof(ini_text_region), allocator->user);
+            if (grown)
+                memcpy(grown, regions, *capacity * sizeof(ini_text_region));
+            allocator->free(regions, *capacity * sizeof(ini_text_region), allocator->user);
+            if (!(regions = grown))
+                return NULL;
+            *capacity *= 2U;
+        }
+
+        ini_text_region* region = &regions[*count];
+        region->data    = start;
+        region->size    = (size_t)(stop - start);
+        region->name    = !*count ? (ini_string){ INI_DEFAULT_SECTION_NAME, sizeof(INI_DEFAULT_SECTION_NAME) - 1 }
+                                  : _region_name(start, region->size);
+        region->section = NULL;
+        region->hash    = _region_hash(start, region->size);
+        (*count)++;
+        if (stop == end)
+            return regions;
+        start = stop;
+    }
+}
+
+static int _region_key_compare(const void* lhs, const void* rhs) {
+    const ini_region_key* left = lhs;
+    const ini_region_key* right = rhs;
+    if (left->section != right->section)
+        return ((uintptr_t)left->section < (uintptr_t)right->section) ? -1 : 1;
+    return (left->index < right->index) ? -1 : (left->index > right->index);
+}
+
+/**
+ *  @brief  folds region hashes of every section into one, the order of the regions matters
+ *  @retval - count of groups, keys are sorted by section
+ */
+static size_t _group_regions(ini_region_key* keys, size_t count) {
+    qsort(keys, count, sizeof(ini_region_key), _region_key_compare);
+    size_t groups = 0U;
+    for (size_t i = 0; i < count; i++)
+        if (groups && keys[groups - 1U].section == keys[i].section)
+            keys[groups - 1U].hash = (keys[groups - 1U].hash ^ keys[i].hash) * REGION_HASH_MUL;
+        else
+            keys[groups++] = keys[i];
+    return groups;
+}
+
+static int _section_compare(const void* lhs, const void* rhs) {
+    uintptr_t left  = (uintptr_t)*(const ini_section* const*)lhs;
+    uintptr_t right = (uintptr_t)*(const ini_section* const*)rhs;
+    return (left > right) - (left < right);
+}
+
+/**
+ *  @brief sections of the file whose regions changed since the last update, sorted by address
+ */
+typedef struct ini_changed_sections {
+    const ini_section** items; //!< top level sections (allocator memory)
+    size_t count;              //!< count of sections
+    size_t capacity;           //!< allocated items
+    bool all;                  //!< the previous text is unknown, every section is changed
+} ini_changed_sections;
+
+static bool _is_changed(const ini_changed_sections* changed, const ini_section* section) {
+    const ini_section* top = _section_top(section);
+    return changed->all || (changed->count && bsearch(&top, changed->items, changed->count, sizeof(ini_section*), _section_compare));
+}
+
+/**
+ *  @brief  compares region groups of the previous text and of the new one
+ *  @retval - false on allocation fail
+ */
+static bool _find_changed(const INI* ini, const ini_text_region* regions, size_t count, ini_changed_sections* changed) {
+    const ini_allocator* allocator = &ini->arena.allocator;
+    size_t total = ini->region_count + count;
+    ini_region_key* keys = allocator->alloc(total * sizeof(ini_region_key), allocator->user);
+    if (!keys)
+        return false;
+    if (!(changed->items = allocator->alloc(total * sizeof(ini_section*), allocator->user))) {
+        allocator->free(keys, total * sizeof(ini_region_key), allocator->user);
+        return false;
+    }
+    changed->capacity = total;
+
+    // the same declarations in the same order: regions are compared one by one
+    bool aligned = ini->region_count == count;
+    for (size_t i = 0; i < count && aligned; i++)
+        aligned = ini->regions[i].section == regions[i].section;
+    if (aligned) {
+        for (size_t i = 0; i < count; i++)
+            if (ini->regions[i].hash != regions[i].hash)
+                changed->items[changed->count++] = regions[i].section;
+        qsort(changed->items, changed->count, sizeof(ini_section*), _section_compare);
+        allocator->free(keys, total * sizeof(ini_region_key), allocator->user);
+        return true;
+    }
+
+    ini_region_key* before = keys;
+    ini_region_key* after  = keys + ini->region_count;
+    for (size_t i = 0; i < ini->region_count; i++)
+        before[i] = (ini_region_key){ .section = ini->regions[i].section, .hash = ini->regions[i].hash, .index = i };
+    for (size_t i = 0; i < count; i++)
+        after[i] = (ini_region_key){ .section = regions[i].section, .hash = regions[i].hash, .index = i };
+    size_t before_count = _group_regions(before, ini->region_count);
+    size_t after_count  = _group_regions(after, count);
+
+    // sections with regions on one side only are changed too; not yet declared ones (NULL) are always parsed
+    size_t i = 0U, j = 0U;
+    while (i < before_count || j < after_count) {
+        if (j == after_count || (i < before_count && (uintptr_t)before[i].section < (uintptr_t)after[j].section))
+            changed->items[changed->count++] = before[i++].section;
+        else if (i == before_count || (uintptr_t)after[j].section < (uintptr_t)before[i].section) {
+            if (after[j].section)
+                changed->items[changed->count++] = after[j].section;
+            j++;
+        }
+        else {
+            if (before[i].hash != after[j].hash)
+                changed->items[changed->count++] = before[i].section;
+            i++;
+            j++;
+        }
+    }
+
+    allocator->free(keys, total * sizeof(ini_region_key), allocator->user);
+    return true;
+}
+
+/**
+ *  @brief  makes properties of the section equal to the reparsed ones
+ *  @param  target - section of the file
+ *  @param  source - the same section of the reparsed text
+ *  @retval        - false on allocation fail
+ */
+static bool _section_update(ini_section* target, const ini_section* source, ini_update_hook hook, void* user) {
+    ini_property_walk iter;
+    ini_property_walk_init(&iter, source->file, source);
+    for (const ini_property* property; (property = ini_property_walk_next(&iter)); ) {
+        ini_property* found = ini_find_property(target, property->key.data, property->key.length);
+        ini_change_type type = INI_CHANGE_MODIFIED;
+        if (!found) {
+            if (!(found = ini_property_ensure(target, property->key.data, property->key.length)))
+                return false;
+            type = INI_CHANGE_ADDED;
+        }
+        ini_value value = ini_value_unpack(&property->value);
+        if (type == INI_CHANGE_MODIFIED && _value_equals(ini_value_unpack(&found->value), value))
+            continue;
+        if (!ini_property_store(found, value))
+            return false;
+        hook(type, target, found, user);
+    }
+
+    // removal doesn't move the entries of the walk
+    ini_property_walk_init(&iter, target->file, target);
+    for (ini_property* property; (property = ini_property_walk_next(&iter)); ) {
+        if (!ini_find_property(source, property->key.data, property->key.length)) {
+            hook(INI_CHANGE_REMOVED, target, property, user);
+            ini_property_remove(property);
+        }
+    }
+    return true;
+}
+
+/**
+ *  @brief  applies reparsed sections to the file
+ *  @param  next - file built from the regions of the changed sections
+ *  @retval      - false on allocation fail
+ */
+static bool _apply_changes(INI* ini, const INI* next, const ini_changed_sections* changed, ini_update_hook hook, void* user) {
+    // subsections are declared after their parents, so a removed parent is met first
+    ini_section_walk iter;
+    ini_section_walk_init(&iter, ini);
+    for (ini_section* section; (section = ini_section_walk_next(&iter)); ) {
+        if (_is_changed(changed, section) && !_section_lookup(next, section)) {
+            hook(INI_CHANGE_REMOVED, section, NULL, user);
+            _section_unlink(section);
+        }
+    }
+
+    // every reparsed text has the root section, it is skipped unless its own regions changed
+    ini_parse_ctx ctx = { .file = ini, .stream = NULL, .copy = true, .failed = false };
+    ini_section_walk_init(&iter, next);
+    for (const ini_section* section; (section = ini_section_walk_next(&iter)); ) {
+        ini_section* target = _section_lookup(ini, section);
+        if (target && !_is_changed(changed, target))
+            continue;
+        if (!target) {
+            if (!(target = _section_resolve(&ctx, section)))
+                return false;
+            hook(INI_CHANGE_ADDED, target, NULL, user);
+        }
+        if (!_section_update(target, section, hook, user))
+            return false;
+    }
+    return true;
+}
+
+/**
+ *  @brief  keeps fingerprints of the applied text for the next update
+ *  @retval - false on allocation fail (the next update compares everything)
+ */
+static bool _store_regions(INI* ini, const ini_text_region* regions, size_t count) {
+    const ini_allocator* allocator = &ini->arena.allocator;
+    if (ini->regions)
+        allocator->free(ini->regions, ini->region_count * sizeof(ini_region), allocator->user);
+    ini->region_count = 0U;
+    if (!(ini->regions = allocator->alloc(count * sizeof(ini_region), allocator->user)))
+        return false;
+
+    for (size_t i = 0; i < count; i++) {
+        ini_section* section = regions[i].section;
+        if (!section && !(section = ini_find_section(ini, regions[i].name.data, regions[i].name.length))) {
+            allocator->free(ini->regions, count * sizeof(ini_region), allocator->user);
+            ini->regions = NULL;
+            return false;
+        }
+        ini->regions[i] = (ini_region){ .section = section, .hash = regions[i].hash };
+    }
+    ini->region_count = count;
+    return true;
+}
 
+bool ini_tokenize_update(INI* ini, char* buffer, size_t size, ini_update_hook hook, void* user) {
+    const ini_allocator* allocator = &ini->arena.allocator;
+    ini_parse_ctx error = { .file = ini, .stream = NULL, .copy = true, .failed = false };
+    _diagnostics_reset(ini);
+
+    // regions are hashed before the parser unescapes them in place
+    size_t count = 0U, capacity = 0U;
+    ini_text_region* regions = _split_regions(allocator, buffer, size, &count, &capacity);
+    if (!regions) {
+        _parse_error(&error, EINI_MEMF);
+        return false;
+    }
+    for (size_t i = 0; i < count; i++)
+        regions[i].section = ini_find_section(ini, regions[i].name.data, regions[i].name.length);
+
+    ini_changed_sections changed = { .items = NULL, .count = 0U, .capacity = 0U, .all = !ini->regions };
+    INI* next = NULL;
+    if ((!changed.all && !_find_changed(ini, regions, count, &changed)) || !(next = ini_create(allocator))) {
+        _parse_error(&error, EINI_MEMF);
+        goto _CLEANUP;
+    }
 
+    // only regions of the changed sections are parsed, rows still count from the start of the text
+    next->lazy = ini->lazy;
+    ini_parse_ctx ctx = { .file = next, .stream = NULL, .copy = true, .failed = false };
+    int row = 0;
+    const char* counted = buffer;
+    size_t parsed = 0U;
+    for (size_t i = 0; i < count && !ctx.failed; i++) {
+        ini_text_region* region = &regions[i];
+        if (region->section && !_is_changed(&changed, region->section))
+            continue;
+        row += _count_rows(counted, (size_t)(region->data - counted));
+        counted = region->data;
+        _tokenize(&ctx, region->data, region->size, row);
+        parsed++;
+    }
+    for (size_t i = 0; i < next->diagnostic_count; i++)
+        _diagnostic_push(ini, next->diagnostics[i].type, next->diagnostics[i].row, next->diagnostics[i].column);
+    if (next->last_error != EINI_NO)
+        ini->last_error = next->last_error;
+
+    // nothing changed when no region was parsed and no section lost its regions
+    if (ctx.failed || ((parsed || changed.count) && !_apply_changes(ini, next, &changed, hook, user)))
+        _parse_error(&error, EINI_MEMF);
+    else if (!_store_regions(ini, regions, count))
+        _parse_error(&error, EINI_MEMF);
+
+_CLEANUP:
+    // after a fail the file may be partly updated, the next update compares everything
+    if (error.failed && ini->regions) {
+        allocator->free(ini->regions, ini->region_count * sizeof(ini_region), allocator->user);
+        ini->regions      = NULL;
+        ini->region_count = 0U;
+    }
+    ini_destroy(next);
+    if (changed.items)
+        allocator->free(changed.items, changed.capacity * sizeof(ini_section*), allocator->user);
+    allocator->free(regions, capacity * sizeof(ini_text_region), allocator->user);
+    return !error.failed;
+}
 
-    // start parsing
-    char buffer[INI_PARSER_BUFFER_SIZE + 1] = { '\0' };
-    size_t string_count = 0U;
+int ini_parse_buffer(char* buffer, size_t size, const ini_callbacks* callbacks, void* user) {
+    if (!buffer || !callbacks)
+        return 0;
+
+    ini_stream_state state = { .callbacks = callbacks, .user = user, .row = 0, .depth = 0U, .stopped = false };
+    return _parse_window(&state, buffer, size);
+}
+
+/**
+ *  @brief  streams file through a window
+ *  @param  state     - parser state
+ *  @param  stream    - opened file
+ *  @param  allocator - memory of a window grown for a long line, NULL - a line longer
+ *                      than INI_STREAM_BUFFER_SIZE is reported as EINI_TOOLNG and skipped
+ *  @retval           - count of consumed rows
+ */
+static int _parse_stream(ini_stream_state* state, FILE* stream, const ini_allocator* allocator) {
+    char window[INI_STREAM_BUFFER_SIZE];
+    char* buffer = window;
+    size_t capacity = sizeof(window);
+    size_t filled  = 0U;
+    size_t scanned = 0U; //!< bytes of the window already searched for a line end
+    bool eof  = false;
+    bool skip = false;   //!< the rest of a too long line is dropped
+
+    while (!state->stopped) {
+        if (!eof) {
+            size_t wanted = capacity - filled;
+            size_t readed = fread(buffer + filled, 1U, wanted, stream);
+            filled += readed;
+            eof = readed < wanted;
+        }
+        if (!filled)
+            break;
 
-    while (fgets(buffer, PARSER_BUFFER_SIZE - 1, file) != EOF) {
-        char* first_special_char = strpbrk(buffer, INI_SPECIAL_CHARS);
-        if (!first_special_char) {
-            trim(buffer);
-            if (strlen(buffer) != 0) {
-                ini_parse_error.type = EINI_INVALTK;
-                ini_parse_error.row  = string_count;
+        // only complete lines are lexed, the tail is moved to the start of the window
+        size_t size;
+        if (skip) {
+            size = _first_line(buffer, filled);
+            skip = !size && !eof;
+            if (!size)
+                size = filled;
+            state->row += _count_rows(buffer, size);
+        }
+        else if ((size = eof ? filled : _complete_lines(buffer, scanned, filled)))
+            state->row += _parse_window(state, buffer, size);
+        else if (allocator) {
+            // the whole window is a single incomplete line
+            char* grown = allocator->alloc(capacity * 2U, allocator->user);
+            if (!grown) {
+                _emit_error(state, EINI_MEMF, -1, -1);
                 break;
             }
-            else
-                continue;
+            memcpy(grown, buffer, filled);
+            if (buffer != window)
+                allocator->free(buffer, capacity, allocator->user);
+            buffer    = grown;
+            capacity *= 2U;
         }
-        switch (*first_special_char)
-        {
-        case INI_COMMENT:
-        case INI_COMMENT_ALIAS:
-            *first_special_char = '\0';
-            trim(buffer);
-            if (strlen(buffer) != 0) {
-                ini_parse_error.type = EINI_INVALTK;
-                ini_parse_error.row  = string_count;
+        else {
+            _emit_error(state, EINI_TOOLNG, 1, 1);
+            skip = true;
+            size = filled;
+            state->row += _count_rows(buffer, size);
+        }
+        memmove(buffer, buffer + size, filled - size);
+        filled -= size;
+        scanned = skip ? 0U : filled;
+    }
+
+    if (buffer != window)
+        allocator->free(buffer, capacity, allocator->user);
+    if (ferror(stream))
+        _emit_error(state, EINI_OCF, -1, -1);
+    return state->row;
+}
+
+int ini_parse_stream(FILE* stream, const ini_callbacks* callbacks, void* user) {
+    if (!stream || !callbacks)
+        return 0;
+
+    ini_stream_state state = { .callbacks = callbacks, .user = user, .row = 0, .depth = 0U, .stopped = false };
+    return _parse_stream(&state, stream, NULL);
+}
+
+/**
+ *  @brief push parser state
+ */
+struct ini_parser {
+    ini_parse_ctx ctx;      //!< builder of the file
+    ini_stream_state state; //!< lexer state between fragments
+    char* buffer;           //!< incomplete tail of the text
+    size_t filled;          //!< tail size
+    size_t scanned;         //!< bytes of the tail already searched for a line end
+    size_t capacity;        //!< buffer size
+};
+
+ini_parser* ini_parser_create(_NULLABLE const ini_allocator* allocator) {
+    if (!allocator)
+        allocator = &ini_default_allocator;
+
+    ini_parser* parser = allocator->alloc(sizeof(ini_parser), allocator->user);
+    if (!parser)
+        return NULL;
+    memset(parser, 0, sizeof(ini_parser));
+
+    parser->capacity = INI_STREAM_BUFFER_SIZE;
+    parser->buffer   = allocator->alloc(parser->capacity, allocator->user);
+    parser->ctx.file = ini_create(allocator);
+    parser->ctx.copy = true;
+    if (!parser->buffer || !parser->ctx.file || !_build_root(&parser->ctx)) {
+        if (parser->buffer)
+            allocator->free(parser->buffer, parser->capacity, allocator->user);
+        ini_destroy(parser->ctx.file);
+        allocator->free(parser, sizeof(ini_parser), allocator->user);
+        return NULL;
+    }
+
+    parser->state = (ini_stream_state){ .callbacks = &_builder, .user = &parser->ctx, .row = 0, .depth = 0U, .stopped = false };
+    parser->ctx.stream = &parser->state;
+    return parser;
+}
+
+bool ini_parser_feed(ini_parser* parser, const char* data, size_t size) {
+    if (!parser || (!data && size))
+        return false;
+
+    const ini_allocator* allocator = &parser->ctx.file->arena.allocator;
+    while (size && !parser->state.stopped) {
+        // the whole buffer is a single incomplete line
+        if (parser->filled == parser->capacity) {
+            char* buffer = allocator->alloc(parser->capacity * 2U, allocator->user);
+            if (!buffer) {
+                _parse_error(&parser->ctx, EINI_MEMF);
+                parser->state.stopped = true;
                 break;
             }
-            else
-                continue;
-        case SECTION_OPEN_BRACKET:
-        case SECTION_CLOSE_BRACKET:
-            // check if token has leading trash before section/subsection
-            //      "error: bad section/subsection syntax at ___ row. leading trash"
-            // find close bracket
-            //   if (found)
-            //      check if string has tailing trash after section/subsection
-            //      switch (string)
-            //      case (comment):
-            //          break;
-            //      case (trash):
-            //          "error: bad section/subsection syntax at ___ row. tailing trash"
-            //      default:
-            //          break;
-            //      trim token
-            //      lower token
-            //      validate token with section_alphabet
-            //      if (!valid)
-            //          "error: bad section/subsection syntax at ___ row. invalid section name."
-            //      check depth, if subsection
-            //      if (too deep)
-            //          "error: bad subsection syntax at ___ row. too deep."
-            //      check section/subsection in INI
-            //      if (found)
-            //!         set this section/subsection
-            //      else
-            //!         add new section/subsection
-            //   else
-            //      "error: bad section/subsection syntax at ___ row. unclosed bracket."
-        case PROPERTY_DELIMITER:
-        case PROPERTY_DELIMITER_ALIAS:
-            // 
-            // 
-            // 
-            // 
-            // 
-        default:
-            break;
+            memcpy(buffer, parser->buffer, parser->filled);
+            allocator->free(parser->buffer, parser->capacity, allocator->user);
+            parser->buffer    = buffer;
+            parser->capacity *= 2U;
+        }
+
+        size_t part = parser->capacity - parser->filled;
+        if (part > size)
+            part = size;
+        memcpy(parser->buffer + parser->filled, data, part);
+        parser->filled += part;
+        data += part;
+        size -= part;
+
+        // only complete lines are lexed, the tail waits for the next fragment
+        size_t lines = _complete_lines(parser->buffer, parser->scanned, parser->filled);
+        if (lines) {
+            parser->state.row += _parse_window(&parser->state, parser->buffer, lines);
+            memmove(parser->buffer, parser->buffer + lines, parser->filled - lines);
+            parser->filled -= lines;
         }
-        const char _comment_scanset[]  = " %*[" INI_COMMENT "]"; //!< whitespaces [#;]
-        const char _section_scanset[]  = " " INI_SECTION_OPEN_BRACKET " %[0-9a-zA-Z._] " INI_SECTION_CLOSE_BRACKET; //!< whitespaces '[' whitespaces [0-9a-zA-Z._] whitespaces ']' 
-        const char _property_scanset[] = " %[0-9a-zA-Z_] %*[" INI_PROPERTY_DELIMITER "] %[^" INI_COMMENT "\r\n]"; //!< whitespaces [0-9a-zA-Z_] [=;] [^#;]
+        parser->scanned = parser->filled;
+    }
+    return !parser->state.stopped;
+}
+
+INI* ini_parser_finish(ini_parser* parser) {
+    if (!parser)
+        return NULL;
+
+    if (!parser->state.stopped && parser->filled)
+        _parse_window(&parser->state, parser->buffer, parser->filled);
+
+    INI* file = parser->ctx.file;
+    const ini_allocator* allocator = &file->arena.allocator;
+    allocator->free(parser->buffer, parser->capacity, allocator->user);
+    allocator->free(parser, sizeof(ini_parser), allocator->user);
+    return file;
+}
+
+void ini_tokenize(INI* ini) {
+    _diagnostics_reset(ini);
+
+    FILE* file = fopen(ini->path, "rb");
+    if (!file) {
+        _diagnostic_push(ini, EINI_OCF, -1, -1);
+        return;
     }
 
+    // the file is streamed through a window, the arena is still sized for it at once
+    if (fseek(file, 0L, SEEK_END) == 0) {
+        long size = ftell(file);
+        if (size > 0L)
+            ini_arena_reserve(&ini->arena, (size_t)size);
+    }
+    rewind(file);
+
+    ini_parse_ctx ctx = { .file = ini, .copy = true, .failed = false };
+    ini_stream_state state = { .callbacks = &_builder, .user = &ctx, .row = 0, .depth = 0U, .stopped = false };
+    ctx.stream = &state;
+    if (_build_root(&ctx))
+        _parse_stream(&state, file, &ini->arena.allocator);
     fclose(file);
+}
+
+ini_hash ini_key_hash(const char* key, size_t size) {
+    return default_hash(key, size);
+}
+
+ini_section* ini_find_section(const INI* ini, const char* name, size_t size) {
+    ini_section_key key = { .parent = NULL, .name = name, .size = size };
+    const ini_frozen* frozen = ini->frozen;
+    if (!frozen)
+        return ini_table_find(&ini->sections, _section_hash(NULL, name, size), _section_match_dotted, &key);
+    if (!frozen->sections.count)
+        return NULL;
+
+    uint32_t slot = ini_phash_slot(&frozen->sections, ini_phash_key(name, size, true));
+    ini_section* section = ini_store_at(&ini->section_store, frozen->section_slots[slot]);
+    return _section_match_dotted(section, &key) ? section : NULL;
+}
+
+ini_property* ini_find_property(const ini_section* section, const char* key, size_t size) {
+    ini_string lookup = { .data = key, .length = size };
+    return ini_table_find(&section->properties, default_hash(key, size), _property_match, &lookup);
+}
+
+ini_property* ini_find_property_atom(const ini_section* section, const ini_atom* key) {
+    return ini_table_find(&section->properties, key->hash, _property_match_handle, &key->handle);
+}
+
+ini_property* ini_lookup_property(const INI* ini, const char* section, size_t section_size, const char* key, size_t key_size) {
+    const ini_frozen* frozen = ini->frozen;
+    if (!frozen) {
+        const ini_section* found = ini_find_section(ini, section, section_size);
+        return found ? ini_find_property(found, key, key_size) : NULL;
+    }
+    if (!frozen->properties.count)
+        return NULL;
+
+    uint64_t pair = ini_phash_pair(ini_phash_key(section, section_size, true), ini_phash_key(key, key_size, false));
+    uint32_t slot = ini_phash_slot(&frozen->properties, pair);
+    ini_property* property = ini_store_at(&ini->property_store, frozen->property_slots[slot]);
+    ini_section_key lookup = { .parent = NULL, .name = section, .size = section_size };
+    if (property->key.length != key_size || memcmp(property->key.data, key, key_size) ||
+        !_section_match_dotted(property->section, &lookup))
+        return NULL;
+    return property;
+}
+
+void ini_lookup_properties(const INI* ini, const ini_query* queries, size_t count, ini_property** out) {
+    ini_lookup_batch batch = { .queries = queries, .count = count };
+    for (size_t i = 0; i < count; i++) {
+        batch.sections[i]      = queries[i].section ? queries[i].section : "root";
+        batch.section_sizes[i] = strlen(batch.sections[i]);
+        batch.key_sizes[i]     = queries[i].key ? strlen(queries[i].key) : 0U;
+    }
+    if (ini->frozen)
+        _lookup_frozen(ini, &batch, out);
+    else
+        _lookup_tables(ini, &batch, out);
+}
+
+bool ini_tables_freeze(INI* file) {
+    if (file->frozen)
+        return true;
+
+    const ini_allocator* allocator = &file->arena.allocator;
+    ini_freeze_ctx ctx = { .file = file, .keys = NULL, .indices = NULL, .name = NULL, .name_capacity = 0U };
+    ctx.capacity = file->section_store.count > file->property_store.count ? file->section_store.count : file->property_store.count;
+    ctx.keys     = allocator->alloc(ctx.capacity * sizeof(uint64_t), allocator->user);
+    ctx.indices  = allocator->alloc(ctx.capacity * sizeof(ini_store_index), allocator->user);
+
+    // the tables are published only when both are built
+    ini_frozen* frozen = NULL;
+    if (ctx.keys && ctx.indices && (frozen = ini_arena_alloc(&file->arena, sizeof(ini_frozen))) && !_frozen_fill(&ctx, frozen))
+        frozen = NULL;
+    file->frozen = frozen;
+
+    if (ctx.keys)
+        allocator->free(ctx.keys, ctx.capacity * sizeof(uint64_t), allocator->user);
+    if (ctx.indices)
+        allocator->free(ctx.indices, ctx.capacity * sizeof(ini_store_index), allocator->user);
+    if (ctx.name)
+        allocator->free(ctx.name, ctx.name_capacity, allocator->user);
+    return frozen != NULL;
+}
+
+ini_value ini_value_resolve(const ini_value value) {
+    if (value.type != INI_RAW)
+        return value;
+
+    // a range error of a lazy value has no position to report, the value is just dropped
+    ini_value typed;
+    switch (_value_number(value.vstring.data, value.vstring.length, &typed))
+    {
+    case INI_NUMBER_OK:
+        return typed;
+    case INI_NUMBER_RANGE:
+        return ini_value_default(INI_NONE);
+    default:
+        return (ini_value){ .type = INI_STRING, .vstring = value.vstring };
+    }
+}
+
+ini_value ini_property_value(ini_property* property) {
+    ini_value value = ini_value_unpack(&property->value);
+    if (value.type == INI_RAW) {
+        // a string stays where the raw text is, only its type changes
+        value = ini_value_resolve(value);
+        if (value.type == INI_STRING)
+            property->value.type = INI_STRING;
+        else
+            _packed_scalar(&property->value, value);
+    }
+    return value;
+}
+
+ini_section* ini_section_ensure(INI* file, const char* name, size_t size) {
+    ini_parse_ctx ctx = { .file = file, .stream = NULL, .copy = true, .failed = false };
+    ini_section* section = NULL;
+    const char* end = name + size;
+
+    // the whole name is checked first, so an invalid one creates nothing
+    const char* part = name;
+    uint8_t depth = 0U;
+    for (const char* dot; (dot = memchr(part, '.', (size_t)(end - part))); part = dot + 1, depth++)
+        if (depth >= INI_MAX_DEPTH || !_is_name(part, (size_t)(dot - part), false))
+            return NULL;
+    if (!_is_name(part, (size_t)(end - part), false))
+        return NULL;
+
+    for (depth = 0U; ; depth++) {
+        const char* dot = memchr(name, '.', (size_t)(end - name));
+        const char* stop = dot ? dot : end;
+        if (!(section = _section_get(&ctx, name, (size_t)(stop - name), section, depth)))
+            return NULL;
+        if (!dot)
+            return section;
+        name = dot + 1;
+    }
+}
+
+ini_property* ini_property_ensure(ini_section* section, const char* key, size_t size) {
+    if (!_is_name(key, size, true))
+        return NULL;
+
+    ini_parse_ctx ctx = { .file = section->file, .stream = NULL, .copy = true, .failed = false };
+    const ini_atom* atom = ini_atom_intern(section->file, key, size, true);
+    if (!atom)
+        return NULL;
+    ini_property* property = ini_find_property_atom(section, atom);
+    if (property)
+        return property;
+    ini_store_index index;
+    if (!(property = _property_alloc(&ctx, atom, section, &index)) || !_property_integrate(property, index))
+        return NULL;
+    return property;
+}
+
+void ini_property_remove(ini_property* property) {
+    if (property->removed)
+        return;
+    ini_section* section = property->section;
+    section->file->frozen = NULL;
+    ini_table_remove(&section->properties, property->hash, _same_item, property);
+    property->removed = true;
+    section->entries.removed++;
+}
+
+bool ini_property_store(ini_property* property, const ini_value value) {
+    ini_packed* packed = &property->value;
+    if (value.type != INI_STRING && value.type != INI_RAW) {
+        _packed_scalar(packed, value);
+        return true;
+    }
+
+    size_t length = value.vstring.length;
+    if (length <= INI_PACKED_INLINE) {
+        _packed_inline(packed, value.type, value.vstring.data, length);
+        return true;
+    }
+    if (length > UINT32_MAX)
+        return false;
+
+    // storage is set only for a text owned by the file, so a new text that fits is copied over it
+    bool outer = (packed->type == INI_STRING || packed->type == INI_RAW) && !packed->size;
+    char* text = (char*)packed->data;
+    uint8_t storage = packed->storage;
+    if (!outer || !storage || length >= ((size_t)1U << storage)) {
+        storage = (uint8_t)(bit_msb32((uint32_t)length) + 1U);
+        if (!(text = ini_arena_alloc(&property->section->file->arena, (size_t)1U << storage)))
+            return false;
+    }
+    memmove(text, value.vstring.data, length);
+    text[length] = '\0';
+    _packed_outer(packed, value.type, text, length, storage);
+    return true;
+}
+
+size_t ini_section_name_length(const ini_section* section) {
+    return section->name.length + (section->parent ? ini_section_name_length(section->parent) + 1U : 0U);
+}
+
+char* ini_section_name_write(char* out, const ini_section* section) {
+    if (section->parent) {
+        out = ini_section_name_write(out, section->parent);
+        *(out++) = '.';
+    }
+    memcpy(out, section->name.data, section->name.length);
+    return out + section->name.length;
+}
+
+void ini_section_remove(ini_section* section) {
+    // the last subsection is taken from the end of the list at once
+    while (section->children.count)
+        ini_section_remove(section->children.items[section->children.count - 1U]);
+    _section_unlink(section);
+}
+
+ini_section* const* ini_section_children(INI* file, ini_section* section, size_t* count) {
+    ini_section_list* list = _list_sorted(section ? &section->children : &file->tree);
+    *count = list->count;
+    return list->items;
+}
+
+void ini_find_prefix(INI* file, const char* prefix, size_t size, ini_section_iterator* iterator) {
+    iterator->depth = 0U;
+
+    // complete parts of the prefix name the parent, the last one is a prefix of its subsections
+    ini_section_list* siblings = &file->tree;
+    const char* dot = prefix + size;
+    while (dot > prefix && dot[-1] != '.')
+        dot--;
+    if (dot > prefix) {
+        ini_section* parent = ini_find_section(file, prefix, (size_t)(dot - prefix - 1));
+        if (!parent)
+            return;
+        siblings = &parent->children;
+        size -= (size_t)(dot - prefix);
+        prefix = dot;
+    }
+
+    _list_sorted(siblings);
+    size_t low = 0U, high = siblings->count;
+    while (low < high) {
+        size_t middle = low + (high - low) / 2U;
+        if (_prefix_compare(siblings->items[middle], prefix, size) < 0)
+            low = middle + 1U;
+        else
+            high = middle;
+    }
+    size_t first = low;
+    high = siblings->count;
+    while (low < high) {
+        size_t middle = low + (high - low) / 2U;
+        if (_prefix_compare(siblings->items[middle], prefix, size) <= 0)
+            low = middle + 1U;
+        else
+            high = middle;
+    }
+
+    if (low > first)
+        iterator->frames[iterator->depth++] = (ini_iterator_frame){ .items = siblings->items + first, .count = low - first };
+}
 
-    // TODO: place for error goto labels
+void ini_section_subtree(ini_section* section, ini_section_iterator* iterator) {
+    iterator->depth = 0U;
+    ini_section_list* children = _list_sorted(&section->children);
+    if (children->count)
+        iterator->frames[iterator->depth++] = (ini_iterator_frame){ .items = children->items, .count = children->count };
 }
 
-char* section_validate(char* str) {
+ini_section* ini_section_next(ini_section_iterator* iterator) {
+    while (iterator->depth && !iterator->frames[iterator->depth - 1U].count)
+        iterator->depth--;
+    if (!iterator->depth)
+        return NULL;
 
+    ini_iterator_frame* frame = &iterator->frames[iterator->depth - 1U];
+    ini_section* section = *frame->items++;
+    frame->count--;
+
+    // subsections go right after their parent, a frame per depth is enough
+    ini_section_list* children = _list_sorted(&section->children);
+    if (children->count && iterator->depth < INI_ITERATOR_FRAMES)
+        iterator->frames[iterator->depth++] = (ini_iterator_frame){ .items = children->items, .count = children->count };
+    return section;
 }
 
-char* key_validate(char* str) {
+void ini_section_tree_sort(INI* file) {
+    _list_sorted(&file->tree);
+    ini_section_walk iter;
+    ini_section_walk_init(&iter, file);
+    for (ini_section* section; (section = ini_section_walk_next(&iter)); )
+        _list_sorted(&section->children);
+}
 
+void ini_section_walk_init(ini_section_walk* iter, const INI* file) {
+    iter->file  = file;
+    iter->index = 0U;
 }
 
-char* value_vlaidate(char* str) {
+ini_section* ini_section_walk_next(ini_section_walk* iter) {
+    const ini_store* store = &iter->file->section_store;
+    while (iter->index < store->count) {
+        ini_section* section = ini_store_at(store, iter->index++);
+        if (!section->removed)
+            return section;
+    }
+    return NULL;
+}
 
+void ini_property_walk_init(ini_property_walk* iter, const INI* file, const ini_section* section) {
+    iter->file    = file;
+    iter->section = section;
+    iter->index   = 0U;
 }
 
+ini_property* ini_property_walk_next(ini_property_walk* iter) {
+    const ini_store* store = &iter->file->property_store;
+    const ini_section* section = iter->section;
+    if (section) {
+        while (iter->index < section->entries.count) {
+            ini_property* property = ini_store_at(store, section->entries.items[iter->index++]);
+            if (!property->removed)
+                return property;
+        }
+        return NULL;
+    }
 
+    // properties of a removed section aren't removed one by one
+    while (iter->index < store->count) {
+        ini_property* property = ini_store_at(store, (ini_store_index)iter->index++);
+        if (!property->removed && !property->section->removed)
+            return property;
+    }
+    return NULL;
+}
 
 #pragma endregion
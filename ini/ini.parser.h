@@ -17,33 +17,386 @@
 
 #pragma endregion
 
+#pragma region --- MACROS ---
+
+#define INI_STREAM_BUFFER_SIZE (16U << 10) //!< window of ini_parse_stream, max length of a line
+#define INI_ITERATOR_FRAMES    17U         //!< top level and INI_MAX_DEPTH levels of subsections
+#define INI_LOOKUP_BATCH       32U         //!< lookups in flight of ini_lookup_properties
+
+#pragma endregion
+
 #pragma region --- TYPEDEFS ---
 
-typedef enum ini_parse_error_type ini_parse_error_type;
+typedef struct ini_callbacks ini_callbacks;
+typedef struct ini_parser    ini_parser;
+typedef struct ini_iterator_frame   ini_iterator_frame;
+typedef struct ini_section_iterator ini_section_iterator;
+typedef struct ini_section_walk     ini_section_walk;
+typedef struct ini_property_walk    ini_property_walk;
+
+/**
+ *  @brief change applied by ini_tokenize_update, property is NULL for a change of the section itself
+ */
+typedef void (*ini_update_hook)(ini_change_type type, ini_section* section, ini_property* property, void* user);
 
 #pragma endregion
 
-#pragma region --- ENUMS ---
-
-enum ini_parse_error_type {
-    EINI_NO,      // no errors
-    EINI_NPAC,    // null pointer access
-    EINI_MEMF,    // memory allocation fail
-    EINI_OCF,     // open/create fail
-    EINI_INVALTK, // invalid token
-    EINI_LDTRSH,  // string leading trash
-    EINI_TLTRSH,  // string tailing trash
-    EINI_INSEC,   // invalid section name
-    EINI_TOODP,   // subsection too deep
-    EINI_UNBRCK   // unclosed section bracket
+#pragma region --- STRUCTS ---
+
+/**
+ *  @brief  streaming parser events, any of them may be NULL
+ *  @note   spans point into the parsed buffer and are valid only during the call,
+ *          every callback returns false to stop parsing
+ */
+struct ini_callbacks {
+    /**
+     *  @brief section declaration, an empty name at depth 0 returns to the root section ("[]")
+     *  @param name  - name without dots, not null-terminated
+     *  @param depth - count of leading dots, never deeper than the previous section + 1
+     */
+    bool (*on_section)(const ini_string* name, uint8_t depth, void* user);
+
+    /**
+     *  @brief property of the last declared section
+     *  @param key   - property key, not null-terminated
+     *  @param value - trimmed value with resolved escapes, not null-terminated
+     */
+    bool (*on_property)(const ini_string* key, const ini_string* value, void* user);
+
+    /**
+     *  @brief syntax error, the broken line is skipped
+     *  @param row    - row of the error (1 - first one), -1 - not bound to the text
+     *  @param column - column of the error (1 - first one), -1 - not bound to the text
+     */
+    bool (*on_error)(ini_parse_error_type type, int row, int column, void* user);
+};
+
+/**
+ *  @brief sections of a tree level, that are still to visit
+ */
+struct ini_iterator_frame {
+    ini_section* const* items; //!< next section
+    size_t count;              //!< count of left sections
+};
+
+/**
+ *  @brief  depth-first walk over the section tree, sections come in name order,
+ *          every one is followed by its subsections
+ *  @note   the file must not be changed during the walk
+ */
+struct ini_section_iterator {
+    ini_iterator_frame frames[INI_ITERATOR_FRAMES]; //!< levels of the walk
+    size_t depth;                                   //!< count of used frames
+};
+
+/**
+ *  @brief  walk over the sections of a file in declaration order
+ *  @note   sections are read one after another from the dense store of the file
+ */
+struct ini_section_walk {
+    const INI* file;       //!< walked file
+    ini_store_index index; //!< next entry of the section store
+};
+
+/**
+ *  @brief  walk over the properties of a section (or of the whole file) in declaration order
+ *  @note   properties are read from the dense store of the file: a whole file walk reads
+ *          it linearly, a section walk follows the index list of the section
+ */
+struct ini_property_walk {
+    const INI* file;            //!< walked file
+    const ini_section* section; //!< walked section, NULL - every section
+    size_t index;               //!< next index of the section list (or entry of the store)
 };
 
 #pragma endregion
 
 #pragma region --- FUNCTIONS ---
 
+/**
+ *  @brief  parses memory block without building an ini file
+ *  @param  buffer    - ini text, values are unescaped in place
+ *  @param  size      - text size
+ *  @param  callbacks - events
+ *  @param  user      - passed to every event
+ *  @retval           - count of consumed rows
+ */
+int ini_parse_buffer(char* buffer, size_t size, const ini_callbacks* callbacks, void* user);
+
+/**
+ *  @brief  parses stream without building an ini file, nothing is allocated
+ *  @param  stream    - opened stream, read up to the end
+ *  @param  callbacks - events
+ *  @param  user      - passed to every event
+ *  @retval           - count of consumed rows
+ *  @note   the stream is read through a fixed window on the stack, a line (with its
+ *          continuations) longer than INI_STREAM_BUFFER_SIZE is reported as EINI_TOOLNG and skipped
+ */
+int ini_parse_stream(FILE* stream, const ini_callbacks* callbacks, void* user);
+
+/**
+ *  @brief  creates push parser, that builds ini file from fragments of a text
+ *  @param  allocator - memory hooks for the parser and the file, NULL - malloc/free
+ *  @retval           - parser, or NULL if error
+ *  @note   for pipes, sockets and other inputs without a known size,
+ *          the file is built while data is still arriving
+ */
+ini_parser* ini_parser_create(_NULLABLE const ini_allocator* allocator);
+
+/**
+ *  @brief  parses next fragment of the text, tokens are copied
+ *  @param  parser - push parser
+ *  @param  data   - fragment, may split a line (or its continuation) at any byte
+ *  @param  size   - fragment size
+ *  @retval        - false if parsing stopped on a fatal error, the rest is ignored
+ *  @note   complete lines are parsed at once, an incomplete tail is kept until the next fragment,
+ *          the tail buffer grows for lines longer than INI_STREAM_BUFFER_SIZE
+ */
+bool ini_parser_feed(ini_parser* parser, const char* data, size_t size);
+
+/**
+ *  @brief  parses the rest of the text and releases parser
+ *  @param  parser - push parser
+ *  @retval        - built ini file (see ini_get_diagnostic for errors), or NULL if parser is NULL
+ */
+INI* ini_parser_finish(ini_parser* parser);
+
+/**
+ *  @brief parses file by path through ini_parse_stream, tokens are copied
+ *  @param file - ini file with valid path
+ */
 void ini_tokenize(INI* file);
 
+/**
+ *  @brief parses memory block
+ *  @param file   - ini file
+ *  @param buffer - file content, values are unescaped in place
+ *  @param size   - content size
+ *  @param copy   - copy tokens, otherwise they are views into the buffer
+ *                  and the buffer must outlive the file
+ */
+void ini_tokenize_buffer(INI* file, char* buffer, size_t size, bool copy);
+
+/**
+ *  @brief parses memory block with several threads, tokens are views into the buffer
+ *  @param file    - ini file
+ *  @param buffer  - file content, values are unescaped in place
+ *  @param size    - content size
+ *  @param threads - max count of threads, 0 - count of logical processors
+ *  @note  the buffer is split at top level sections, chunks are parsed into
+ *         partial files and merged in file order
+ */
+void ini_tokenize_parallel(INI* file, char* buffer, size_t size, unsigned threads);
+
+/**
+ *  @brief  updates file to the new text, only regions of the changed sections are parsed
+ *  @param  file   - ini file
+ *  @param  buffer - new content, values are unescaped in place, tokens are copied
+ *  @param  size   - content size
+ *  @param  hook   - called for every applied change
+ *  @param  user   - hook argument
+ *  @retval        - false on allocation fail, the file may be partly updated then
+ *  @note   a region is a top level declaration with the text up to the next one, regions
+ *          are compared by hash with the previous update. Sections of the changed regions
+ *          get exactly the properties of the text, the rest of the file isn't touched.
+ *          The first update compares every section. Diagnostics cover parsed regions only
+ */
+bool ini_tokenize_update(INI* file, char* buffer, size_t size, ini_update_hook hook, void* user);
+
+/**
+ *  @brief  hash of a property key, the same as ini_property::hash
+ */
+ini_hash ini_key_hash(const char* key, size_t size);
+
+ini_section* ini_find_section(const INI* file, const char* name, size_t size);
+
+/**
+ *  @brief  length of the dotted name of the section ("settings.com1")
+ */
+size_t ini_section_name_length(const ini_section* section);
+
+/**
+ *  @brief  writes dotted name of the section, not null-terminated
+ *  @param  out - at least ini_section_name_length(section) bytes
+ *  @retval     - end of the name
+ */
+char* ini_section_name_write(char* out, const ini_section* section);
+ini_property* ini_find_property(const ini_section* section, const char* key, size_t size);
+
+/**
+ *  @brief  finds property by interned key, only integer handles are compared
+ *  @param  section - section
+ *  @param  key     - atom of the section file
+ */
+ini_property* ini_find_property_atom(const ini_section* section, const ini_atom* key);
+
+/**
+ *  @brief  finds property by dotted section name and key
+ *  @note   a frozen file finds it by a single probe of ini_frozen::properties
+ */
+ini_property* ini_lookup_property(const INI* file, const char* section, size_t section_size, const char* key, size_t key_size);
+
+/**
+ *  @brief  finds properties of the queries in passes, every pass prefetches memory of the next one
+ *  @param  file    - ini file
+ *  @param  queries - lookups, a NULL key finds nothing
+ *  @param  count   - count of queries, up to INI_LOOKUP_BATCH
+ *  @param  out     - property of every query, NULL if not found
+ */
+void ini_lookup_properties(const INI* file, const ini_query* queries, size_t count, ini_property** out);
+
+/**
+ *  @brief  builds ini_frozen tables of the current names, see ini_freeze
+ *  @retval - false on allocation fail or a clash of 64 bit keys (the file stays as it is)
+ */
+bool ini_tables_freeze(INI* file);
+
+/**
+ *  @brief  types INI_RAW value of a lazy file, other values are returned as is
+ *  @param  value - property value
+ *  @retval       - typed value, or INI_NONE value if the number is out of range
+ *  @note   string values stay views of the raw text
+ */
+ini_value ini_value_resolve(const ini_value value);
+
+/**
+ *  @brief  value of the property, INI_RAW value is typed and cached by the first call
+ *  @param  property - property
+ */
+ini_value ini_property_value(ini_property* property);
+
+/**
+ *  @brief  finds section by dotted name, missing sections of the name are created
+ *  @param  file - ini file
+ *  @param  name - dotted section name ("settings.com1"), parts are [0-9a-zA-Z_]
+ *  @param  size - name length
+ *  @retval      - section, or NULL on allocation fail or invalid name
+ */
+ini_section* ini_section_ensure(INI* file, const char* name, size_t size);
+
+/**
+ *  @brief  finds property, a missing one is created with INI_NONE value
+ *  @param  section - section
+ *  @param  key     - property key, [0-9a-zA-Z_.]
+ *  @param  size    - key length
+ *  @retval         - property, or NULL on allocation fail or invalid key
+ */
+ini_property* ini_property_ensure(ini_section* section, const char* key, size_t size);
+
+/**
+ *  @brief  sets value of the property, text is copied to the file
+ *  @param  property - property
+ *  @param  value    - new value, a text may be a view of the old one
+ *  @retval          - false on allocation fail
+ *  @note   a text is written over the previous one owned by the file when it fits,
+ *          otherwise a buffer of the next power of two is taken from the arena
+ */
+bool ini_property_store(ini_property* property, const ini_value value);
+
+/**
+ *  @brief  unbinds property from its section, the memory is released by ini_destroy
+ *  @param  property - property of a section
+ */
+void ini_property_remove(ini_property* property);
+
+/**
+ *  @brief  unbinds section with all its subsections, the memory is released by ini_destroy
+ *  @param  section - section of a file
+ *  @note   O(1) for the last subsection of the parent list, otherwise a linear scan of the siblings.
+ *          The list is in declaration order until the first query sorts it by name
+ */
+void ini_section_remove(ini_section* section);
+
+/**
+ *  @brief  direct subsections in name order (case insensitive)
+ *  @param  file    - ini file
+ *  @param  section - section of the file, NULL - top level sections
+ *  @param  count   - count of subsections
+ *  @retval         - subsections, valid until the next change of the file
+ *  @note   a list changed since the last query is sorted first, then the call is O(1)
+ */
+ini_section* const* ini_section_children(INI* file, ini_section* section, size_t* count);
+
+/**
+ *  @brief  starts walk over the sections with the full name starting with the prefix
+ *  @param  file     - ini file
+ *  @param  prefix   - start of a dotted name: "settings.com" - "settings.com1" with its subsections,
+ *                     "settings." - every subsection of "settings", "" - every section
+ *  @param  size     - prefix length
+ *  @param  iterator - walk, see ini_section_next
+ *  @note   complete parts are looked up by hash, the last one by binary search, then the walk
+ *          costs O(matches). A snapshot file has no sections to walk
+ */
+void ini_find_prefix(INI* file, const char* prefix, size_t size, ini_section_iterator* iterator);
+
+/**
+ *  @brief starts walk over every subsection of the section (the section itself is skipped)
+ *  @param section  - section
+ *  @param iterator - walk, see ini_section_next
+ */
+void ini_section_subtree(ini_section* section, ini_section_iterator* iterator);
+
+/**
+ *  @brief  next section of the walk
+ *  @param  iterator - walk started by ini_find_prefix or ini_section_subtree
+ *  @retval          - section, or NULL at the end
+ */
+ini_section* ini_section_next(ini_section_iterator* iterator);
+
+/**
+ *  @brief starts walk over the sections of the file in declaration order ("root" goes first)
+ *  @param iter - walk, see ini_section_walk_next
+ *  @param file - ini file, sections added during the walk are met too
+ */
+void ini_section_walk_init(ini_section_walk* iter, const INI* file);
+
+/**
+ *  @brief  next section of the walk, removed sections are skipped
+ *  @param  iter - walk started by ini_section_walk_init
+ *  @retval      - section, or NULL at the end
+ */
+ini_section* ini_section_walk_next(ini_section_walk* iter);
+
+/**
+ *  @brief starts walk over the properties in declaration order
+ *  @param iter    - walk, see ini_property_walk_next
+ *  @param file    - ini file
+ *  @param section - section of the file, NULL - every property of the file
+ *                   (in the order they were added, not grouped by section)
+ *  @note  the met properties may be removed during the walk, other changes of the section aren't allowed
+ */
+void ini_property_walk_init(ini_property_walk* iter, const INI* file, const ini_section* section);
+
+/**
+ *  @brief  next property of the walk, removed properties (and properties of removed sections) are skipped
+ *  @param  iter - walk started by ini_property_walk_init
+ *  @retval      - property, or NULL at the end
+ */
+ini_property* ini_property_walk_next(ini_property_walk* iter);
+
+/**
+ *  @brief sorts every subsection list of the file, so the queries don't change it
+ *  @param file - ini file
+ *  @note  for files read by several threads, see ini_shared_create
+ */
+void ini_section_tree_sort(INI* file);
+
+/**
+ *  @brief  interns string in the pool of the file
+ *  @param  file - ini file
+ *  @param  data - string
+ *  @param  size - string length
+ *  @param  copy - copy new string to the arena, otherwise it must outlive the file
+ *  @retval      - the same atom for equal strings, or NULL on allocation fail
+ */
+ini_atom* ini_atom_intern(INI* file, const char* data, size_t size, bool copy);
+
+/**
+ *  @brief  gets atom by handle
+ *  @retval - atom, or NULL for an unknown handle
+ */
+const ini_atom* ini_atom_get(const INI* file, ini_key_handle handle);
+
 #pragma endregion
 
 #endif // !_INI_PARSER_H_
@@ -0,0 +1,252 @@
+/*******************************************************************************
+ *  @file      ini.phash.c
+ *  @brief     Minimal perfect hash over a fixed set of 64 bit keys
+ *  @author    Young Sideways
+ *  @date      17.10.2026
+ *  @copyright © Young Sideways, 2026. All right reserved.
+ ******************************************************************************/
+
+#include "ini.phash.h"
+
+#pragma region --- INCLUDES ---
+
+#include <string.h>
+
+#pragma endregion
+
+#pragma region --- MACROS ---
+
+#define INI_PHASH_KEY_INIT   0x243F6A8885A308D3ULL
+#define INI_PHASH_KEY_MUL    0x9FB21C651E98DF25ULL
+
+#define INI_PHASH_MAX_BUCKET 64U       //!< larger buckets (almost always equal keys) change the seed
+#define INI_PHASH_MAX_PILOT  0x10000U  //!< pilots tried for a bucket before the seed is changed
+#define INI_PHASH_MAX_SEEDS  8U        //!< seeds tried before the build fails
+
+#define INI_PHASH_ONES       0x0101010101010101ULL
+
+#pragma endregion
+
+#pragma region --- INTERNAL ---
+
+/**
+ *  @brief build state
+ */
+typedef struct ini_phash_ctx {
+    const uint64_t* keys; //!< key set
+    uint32_t* starts;     //!< first key of every bucket in order, bucket_count + 1
+    uint32_t* order;      //!< key indices grouped by bucket
+    uint32_t* buckets;    //!< non-empty buckets, the largest first
+    uint32_t used;        //!< count of non-empty buckets
+    uint32_t* pilots;     //!< pilots under construction
+    uint8_t* taken;       //!< bitmap of taken slots
+} ini_phash_ctx;
+
+/**
+ *  @brief ASCII uppercase letters of the word to lowercase, other bytes are kept
+ */
+static inline uint64_t _lower(uint64_t word) {
+    uint64_t ascii = word & (0x7FU * INI_PHASH_ONES);
+    uint64_t above = ascii + (0x80U - 'A') * INI_PHASH_ONES;      // bit 7 is set for bytes >= 'A'
+    uint64_t after = ascii + (0x80U - 'Z' - 1U) * INI_PHASH_ONES; // bit 7 is set for bytes > 'Z'
+    uint64_t upper = above & ~after & ~word & (0x80U * INI_PHASH_ONES);
+    return word | (upper >> 2);
+}
+
+static inline uint64_t _key_step(uint64_t hash, uint64_t word) {
+    hash = (hash ^ word) * INI_PHASH_KEY_MUL;
+    return hash ^ (hash >> 32);
+}
+
+static inline bool _taken(const ini_phash_ctx* ctx, uint32_t slot) {
+    return (ctx->taken[slot >> 3] >> (slot & 7U)) & 1U;
+}
+
+static inline void _take(ini_phash_ctx* ctx, uint32_t slot) {
+    ctx->taken[slot >> 3] |= (uint8_t)(1U << (slot & 7U));
+}
+
+static inline void _release(ini_phash_ctx* ctx, uint32_t slot) {
+    ctx->taken[slot >> 3] &= (uint8_t)~(1U << (slot & 7U));
+}
+
+/**
+ *  @brief  takes slots of the bucket keys for the pilot
+ *  @retval - false if a slot is taken, nothing is taken then
+ */
+static bool _place(const ini_phash* phash, ini_phash_ctx* ctx, const uint64_t* hashes, uint32_t size, uint32_t pilot) {
+    uint32_t slots[INI_PHASH_MAX_BUCKET];
+    uint64_t mixed = ini_phash_mix(pilot);
+    for (uint32_t i = 0; i < size; i++) {
+        slots[i] = _ini_phash_position(phash, hashes[i], mixed);
+        // keys of the bucket collide with each other as well
+        if (_taken(ctx, slots[i])) {
+            while (i--)
+                _release(ctx, slots[i]);
+            return false;
+        }
+        _take(ctx, slots[i]);
+    }
+    return true;
+}
+
+/**
+ *  @brief  groups keys by bucket with a counting sort, buckets are sorted by size
+ *  @retval - false if a bucket is too large
+ */
+static bool _group(const ini_phash* phash, ini_phash_ctx* ctx) {
+    uint32_t* starts = ctx->starts;
+    memset(starts, 0, ((size_t)phash->bucket_count + 1U) * sizeof(uint32_t));
+    for (uint32_t i = 0; i < phash->count; i++)
+        starts[_ini_phash_bucket(phash, ini_phash_mix(ctx->keys[i] ^ phash->seed))]++;
+
+    uint32_t sizes[INI_PHASH_MAX_BUCKET + 1U] = { 0 };
+    uint32_t first = 0U;
+    for (uint32_t bucket = 0; bucket < phash->bucket_count; bucket++) {
+        uint32_t size = starts[bucket];
+        if (size > INI_PHASH_MAX_BUCKET)
+            return false;
+        sizes[size]++;
+        starts[bucket] = first;
+        first += size;
+    }
+    starts[phash->bucket_count] = first;
+
+    // order[starts[bucket]++] leaves the start of the next bucket, they are shifted back after
+    for (uint32_t i = 0; i < phash->count; i++)
+        ctx->order[starts[_ini_phash_bucket(phash, ini_phash_mix(ctx->keys[i] ^ phash->seed))]++] = i;
+    memmove(starts + 1, starts, (size_t)phash->bucket_count * sizeof(uint32_t));
+    starts[0] = 0U;
+
+    // the largest buckets go first, while the table is empty
+    first = 0U;
+    for (uint32_t size = INI_PHASH_MAX_BUCKET; size; size--) {
+        uint32_t count = sizes[size];
+        sizes[size] = first;
+        first += count;
+    }
+    for (uint32_t bucket = 0; bucket < phash->bucket_count; bucket++) {
+        uint32_t size = starts[bucket + 1U] - starts[bucket];
+        if (size)
+            ctx->buckets[sizes[size]++] = bucket;
+    }
+    ctx->used = first;
+    return true;
+}
+
+/**
+ *  @brief  searches pilots for the current seed
+ *  @retval - 1 on success, 0 - another seed may succeed, -1 - equal keys
+ */
+static int _try_seed(ini_phash* phash, ini_phash_ctx* ctx) {
+    if (!_group(phash, ctx))
+        return 0;
+    memset(ctx->taken, 0, ((size_t)phash->count + 7U) / 8U);
+    memset(ctx->pilots, 0, (size_t)phash->bucket_count * sizeof(uint32_t));
+
+    uint32_t index = 0U;
+    for (; index < ctx->used; index++) {
+        uint32_t bucket = ctx->buckets[index];
+        uint32_t first = ctx->starts[bucket];
+        uint32_t size = ctx->starts[bucket + 1U] - first;
+        if (size < 2U)
+            break;
+
+        // equal keys never get different slots
+        uint64_t hashes[INI_PHASH_MAX_BUCKET];
+        for (uint32_t i = 0; i < size; i++) {
+            hashes[i] = ini_phash_mix(ctx->keys[ctx->order[first + i]] ^ phash->seed);
+            for (uint32_t j = 0; j < i; j++)
+                if (hashes[j] == hashes[i])
+                    return -1;
+        }
+
+        uint32_t pilot = 0U;
+        while (pilot < INI_PHASH_MAX_PILOT && !_place(phash, ctx, hashes, size, pilot))
+            pilot++;
+        if (pilot == INI_PHASH_MAX_PILOT)
+            return 0;
+        ctx->pilots[bucket] = pilot;
+    }
+
+    // single keys take free slots as they are
+    uint32_t slot = 0U;
+    for (; index < ctx->used; index++) {
+        uint32_t bucket = ctx->buckets[index];
+        while (_taken(ctx, slot))
+            slot++;
+        _take(ctx, slot);
+        ctx->pilots[bucket] = INI_PHASH_DIRECT | slot;
+    }
+    return 1;
+}
+
+/**
+ *  @brief  builds pilots for the seed and bucket count of the table
+ *  @retval - see _try_seed, -1 on allocation fail as well
+ */
+static int _try_build(ini_phash* phash, const uint64_t* keys, ini_arena* arena) {
+    const ini_allocator* allocator = &arena->allocator;
+    size_t starts_size  = ((size_t)phash->bucket_count + 1U) * sizeof(uint32_t);
+    size_t order_size   = (size_t)phash->count * sizeof(uint32_t);
+    size_t buckets_size = (size_t)phash->bucket_count * sizeof(uint32_t);
+    size_t size = starts_size + order_size + 2U * buckets_size + ((size_t)phash->count + 7U) / 8U;
+    uint8_t* memory = allocator->alloc(size, allocator->user);
+    if (!memory)
+        return -1;
+
+    ini_phash_ctx ctx = {
+        .keys    = keys,
+        .starts  = (uint32_t*)memory,
+        .order   = (uint32_t*)(memory + starts_size),
+        .buckets = (uint32_t*)(memory + starts_size + order_size),
+        .pilots  = (uint32_t*)(memory + starts_size + order_size + buckets_size),
+        .taken   = memory + starts_size + order_size + 2U * buckets_size
+    };
+    int result = _try_seed(phash, &ctx);
+    if (result > 0) {
+        if ((phash->pilots = ini_arena_alloc(arena, buckets_size)))
+            memcpy(phash->pilots, ctx.pilots, buckets_size);
+        else
+            result = -1;
+    }
+    allocator->free(memory, size, allocator->user);
+    return result;
+}
+
+#pragma endregion
+
+#pragma region --- FUNCTIONS ---
+
+uint64_t ini_phash_key(const char* data, size_t size, bool lower) {
+    uint64_t hash = INI_PHASH_KEY_INIT ^ size;
+    for (; size >= sizeof(uint64_t); size -= sizeof(uint64_t), data += sizeof(uint64_t)) {
+        uint64_t word;
+        memcpy(&word, data, sizeof(uint64_t));
+        hash = _key_step(hash, lower ? _lower(word) : word);
+    }
+    if (size) {
+        uint64_t word = 0U;
+        memcpy(&word, data, size);
+        hash = _key_step(hash, lower ? _lower(word) : word);
+    }
+    return hash;
+}
+
+bool ini_phash_build(ini_phash* phash, const uint64_t* keys, uint32_t count, ini_arena* arena) {
+    if (count > INI_PHASH_MAX_COUNT)
+        return false;
+
+    phash->count = count;
+    int result = 0;
+    for (uint32_t attempt = 0; attempt < INI_PHASH_MAX_SEEDS && !result; attempt++) {
+        // every other failure halves the load of buckets, then more single keys fill the tail of the table
+        uint64_t buckets = (uint64_t)ini_phash_buckets(count) << (attempt / 2U);
+        phash->bucket_count = (uint32_t)(buckets <= count ? buckets : count + 1U);
+        phash->seed = attempt * 0x9E3779B97F4A7C15ULL;
+        result = _try_build(phash, keys, arena);
+    }
+    return result > 0;
+}
+
+#pragma endregion
@@ -0,0 +1,145 @@
+/*******************************************************************************
+ *  @file      ini.phash.h
+ *  @brief     Minimal perfect hash over a fixed set of 64 bit keys
+ *  @author    Young Sideways
+ *  @date      17.10.2026
+ *  @copyright © Young Sideways, 2026. All right reserved.
+ ******************************************************************************/
+
+#ifndef _INI_PHASH_H_
+#define _INI_PHASH_H_
+
+#pragma once
+
+#pragma region --- INCLUDES ---
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "ini.arena.h"
+
+#pragma endregion
+
+#pragma region --- MACROS ---
+
+#define INI_PHASH_DIRECT    0x80000000U          //!< pilot flag: the bucket keeps a single key, the rest of the pilot is its slot
+#define INI_PHASH_MAX_COUNT (INI_PHASH_DIRECT - 1U) //!< slots fit a direct pilot
+#define INI_PHASH_LAMBDA    2U                   //!< average count of keys in a bucket
+
+#pragma endregion
+
+#pragma region --- TYPEDEFS ---
+
+typedef struct ini_phash ini_phash;
+
+#pragma endregion
+
+#pragma region --- STRUCTS ---
+
+/**
+ *  @brief  maps every key of the set to its own slot in [0, count)
+ *  @note   a key picks a bucket, the pilot of the bucket picks the slot (hash and
+ *          displace, as PTHash). Pilots of single key buckets keep the slot itself.
+ *          A key out of the set gets some slot too, so the slot owner is compared
+ *          with the key. Keys and pilots are plain numbers, the same table is used
+ *          in memory (ini_freeze) and in a snapshot image
+ */
+struct ini_phash {
+    uint64_t seed;         //!< mixed into every key, the build tries another one on a failed search
+    uint32_t count;        //!< count of keys and slots
+    uint32_t bucket_count; //!< count of pilots, grows from ini_phash_buckets(count) on a failed search
+    uint32_t* pilots;      //!< pilot of every bucket
+};
+
+#pragma endregion
+
+#pragma region --- FUNCTIONS ---
+
+/**
+ *  @brief  64 bit hash of a name, a word per step
+ *  @param  lower - ASCII letters are hashed as lowercase (section names are case insensitive)
+ *  @note   a part of the snapshot image format
+ */
+uint64_t ini_phash_key(const char* data, size_t size, bool lower);
+
+/**
+ *  @brief  key of a property: section name key and property key
+ */
+static inline uint64_t ini_phash_pair(uint64_t section, uint64_t key) {
+    return (section * 0x9E3779B97F4A7C15ULL) ^ key;
+}
+
+/**
+ *  @brief  count of pilots the build starts with
+ */
+static inline uint32_t ini_phash_buckets(uint32_t count) {
+    return count / INI_PHASH_LAMBDA + 1U;
+}
+
+static inline uint64_t ini_phash_mix(uint64_t x) {
+    x ^= x >> 33;
+    x *= 0xFF51AFD7ED558CCDULL;
+    x ^= x >> 33;
+    x *= 0xC4CEB9FE1A85EC53ULL;
+    return x ^ (x >> 33);
+}
+
+/**
+ *  @brief bucket of the mixed key, low half of the hash
+ */
+static inline uint32_t _ini_phash_bucket(const ini_phash* phash, uint64_t hash) {
+    return (uint32_t)(((hash & 0xFFFFFFFFU) * phash->bucket_count) >> 32);
+}
+
+/**
+ *  @brief slot of the mixed key for the mixed pilot, high half of the hash
+ */
+static inline uint32_t _ini_phash_position(const ini_phash* phash, uint64_t hash, uint64_t pilot) {
+    return (uint32_t)((((hash ^ pilot) >> 32) * phash->count) >> 32);
+}
+
+/**
+ *  @brief  builds pilots of the key set
+ *  @param  phash - table to build
+ *  @param  keys  - distinct keys
+ *  @param  count - count of keys, up to INI_PHASH_MAX_COUNT
+ *  @param  arena - memory for pilots, temporary memory comes from its allocator
+ *  @retval       - false on allocation fail or equal keys
+ */
+bool ini_phash_build(ini_phash* phash, const uint64_t* keys, uint32_t count, ini_arena* arena);
+
+/**
+ *  @brief  mixed key, the lookup is split into ini_phash_pilot and ini_phash_mixed_slot to prefetch the pilot
+ */
+static inline uint64_t ini_phash_mixed(const ini_phash* phash, uint64_t key) {
+    return ini_phash_mix(key ^ phash->seed);
+}
+
+/**
+ *  @brief  pilot of the mixed key
+ */
+static inline const uint32_t* ini_phash_pilot(const ini_phash* phash, uint64_t hash) {
+    return &phash->pilots[_ini_phash_bucket(phash, hash)];
+}
+
+/**
+ *  @brief  slot of the mixed key
+ */
+static inline uint32_t ini_phash_mixed_slot(const ini_phash* phash, uint64_t hash) {
+    uint32_t pilot = *ini_phash_pilot(phash, hash);
+    return (pilot & INI_PHASH_DIRECT) ? pilot & ~INI_PHASH_DIRECT : _ini_phash_position(phash, hash, ini_phash_mix(pilot));
+}
+
+/**
+ *  @brief  slot of the key, a single read of the pilot array
+ *  @param  phash - built table of non-zero count
+ *  @retval       - slot, below count for a table built here
+ */
+static inline uint32_t ini_phash_slot(const ini_phash* phash, uint64_t key) {
+    return ini_phash_mixed_slot(phash, ini_phash_mixed(phash, key));
+}
+
+#pragma endregion
+
+#endif // !_INI_PHASH_H_
@@ -0,0 +1,199 @@
+/*******************************************************************************
+ *  @file      ini.schema.c
+ *  @brief     Declarative struct binding with a perfect-hashed fill plan
+ *  @author    Young Sideways
+ *  @date      17.10.2026
+ *  @copyright © Young Sideways, 2026. All right reserved.
+ ******************************************************************************/
+
+#include "ini.schema.h"
+
+#pragma region --- INCLUDES ---
+
+#include "ini.parser.h"
+#include "ini.snapshot.h"
+
+#pragma endregion
+
+#pragma region --- MACROS ---
+
+#define INI_SCHEMA_MAX_SEEDS  4096U //!< seeds tried for a table size before it is doubled
+#define INI_SCHEMA_MAX_GROWTH 3U    //!< table doublings above the field count
+
+#pragma endregion
+
+#pragma region --- INTERNAL ---
+
+static inline uint32_t _slot(ini_hash hash, uint32_t seed, unsigned shift) {
+    return (uint32_t)((hash ^ seed) * 0x9E3779B1U) >> shift;
+}
+
+/**
+ *  @brief  places every field into its own slot
+ *  @retval - false on a collision
+ */
+static bool _try_seed(ini_schema* schema, uint32_t seed, unsigned shift) {
+    memset(schema->slots, 0, ((size_t)1U << (32U - shift)) * sizeof(uint16_t));
+    for (size_t i = 0; i < schema->count; i++) {
+        uint16_t* slot = &schema->slots[_slot(schema->entries[i].hash, seed, shift)];
+        if (*slot)
+            return false;
+        *slot = (uint16_t)(i + 1U);
+    }
+    schema->seed  = seed;
+    schema->shift = shift;
+    return true;
+}
+
+static void _field_set(const ini_field* field, void* out, const ini_value value) {
+    void* member = (uint8_t*)out + field->offset;
+    switch (field->type)
+    {
+    case INI_FIELD_TYPE_INT:
+        *(int*)member = ini_to_int(value);
+        break;
+    case INI_FIELD_TYPE_INT64:
+        *(int64_t*)member = ini_to_int64(value);
+        break;
+    case INI_FIELD_TYPE_DOUBLE:
+        *(double*)member = ini_to_double(value);
+        break;
+    case INI_FIELD_TYPE_BOOL:
+        *(bool*)member = ini_to_bool(value);
+        break;
+    case INI_FIELD_TYPE_STRING:
+        if (value.type == INI_STRING)
+            *(ini_string*)member = value.vstring;
+        break;
+    default:
+        break;
+    }
+}
+
+static void _field_default(const ini_field* field, const ini_schema_entry* entry, void* out) {
+    void* member = (uint8_t*)out + field->offset;
+    switch (field->type)
+    {
+    case INI_FIELD_TYPE_INT:
+        *(int*)member = field->def.vint;
+        break;
+    case INI_FIELD_TYPE_INT64:
+        *(int64_t*)member = field->def.vint64;
+        break;
+    case INI_FIELD_TYPE_DOUBLE:
+        *(double*)member = field->def.vdouble;
+        break;
+    case INI_FIELD_TYPE_BOOL:
+        *(bool*)member = field->def.vbool;
+        break;
+    case INI_FIELD_TYPE_STRING:
+        *(ini_string*)member = (ini_string){ field->def.vstring, entry->default_length };
+        break;
+    default:
+        break;
+    }
+}
+
+#pragma endregion
+
+#pragma region --- FUNCTIONS ---
+
+ini_schema* ini_schema_compile(const ini_field* fields, size_t count, _NULLABLE const ini_allocator* allocator) {
+    if ((!fields && count) || count > INI_SCHEMA_MAX_FIELDS)
+        return NULL;
+    if (!allocator)
+        allocator = &ini_default_allocator;
+
+    // slots for the largest table, smaller ones use its prefix
+    unsigned bits = 1U;
+    while (((size_t)1U << bits) < count)
+        bits++;
+    size_t max_slots = (size_t)1U << (bits + INI_SCHEMA_MAX_GROWTH);
+    size_t size = sizeof(ini_schema) + count * sizeof(ini_schema_entry) + max_slots * sizeof(uint16_t);
+
+    ini_schema* schema = allocator->alloc(size, allocator->user);
+    if (!schema)
+        return NULL;
+    schema->fields    = fields;
+    schema->entries   = (ini_schema_entry*)(schema + 1);
+    schema->slots     = (uint16_t*)(schema->entries + count);
+    schema->count     = count;
+    schema->size      = size;
+    schema->allocator = *allocator;
+
+    for (size_t i = 0; i < count; i++) {
+        ini_schema_entry* entry = &schema->entries[i];
+        entry->key_length     = strlen(fields[i].key);
+        entry->hash           = ini_key_hash(fields[i].key, entry->key_length);
+        entry->default_length = (fields[i].type == INI_FIELD_TYPE_STRING && fields[i].def.vstring) ? strlen(fields[i].def.vstring) : 0U;
+
+        // equal hashes can't be told apart by any seed
+        for (size_t j = 0; j < i; j++)
+            if (schema->entries[j].hash == entry->hash) {
+                ini_schema_destroy(schema);
+                return NULL;
+            }
+    }
+
+    for (unsigned growth = 0U; growth <= INI_SCHEMA_MAX_GROWTH; growth++)
+        for (uint32_t seed = 0U; seed < INI_SCHEMA_MAX_SEEDS; seed++)
+            if (_try_seed(schema, seed * 0x85EBCA6BU, 32U - (bits + growth)))
+                return schema;
+
+    ini_schema_destroy(schema);
+    return NULL;
+}
+
+void ini_schema_destroy(ini_schema* schema) {
+    if (!schema)
+        return;
+
+    ini_allocator allocator = schema->allocator;
+    allocator.free(schema, schema->size, allocator.user);
+}
+
+bool ini_schema_fill(const INI* file, const ini_schema* schema, _NULLABLE const char* section, void* out) {
+    if (!file || !schema || !out)
+        return false;
+    if (!section)
+        section = "root";
+
+    for (size_t i = 0; i < schema->count; i++)
+        _field_default(&schema->fields[i], &schema->entries[i], out);
+
+    // snapshot has no property objects, its fields are looked up one by one
+    // (a missing section isn't told from a section without these keys)
+    if (file->snapshot) {
+        for (size_t i = 0; i < schema->count; i++) {
+            const ini_field* field = &schema->fields[i];
+            ini_value value = ini_snapshot_get_value(file->snapshot, section, strlen(section), field->key, schema->entries[i].key_length);
+            if (value.type != INI_NONE)
+                _field_set(field, out, value);
+        }
+        return true;
+    }
+
+    const ini_section* found = ini_find_section(file, section, strlen(section));
+    if (!found)
+        return false;
+
+    // a single pass over the properties, stored key hashes pick the field
+    size_t cursor = 0U;
+    for (ini_property* property; (property = ini_table_next(&found->properties, &cursor)); ) {
+        uint16_t index = schema->count ? schema->slots[_slot(property->hash, schema->seed, schema->shift)] : 0U;
+        if (!index)
+            continue;
+
+        const ini_field* field = &schema->fields[index - 1U];
+        const ini_schema_entry* entry = &schema->entries[index - 1U];
+        if (entry->hash == property->hash && entry->key_length == property->key.length &&
+            memcmp(field->key, property->key.data, entry->key_length) == 0) {
+            ini_value value = ini_property_value(property);
+            if (value.type != INI_NONE)
+                _field_set(field, out, value);
+        }
+    }
+    return true;
+}
+
+#pragma endregion
@@ -0,0 +1,153 @@
+/*******************************************************************************
+ *  @file      ini.schema.h
+ *  @brief     Declarative struct binding with a perfect-hashed fill plan
+ *  @author    Young Sideways
+ *  @date      17.10.2026
+ *  @copyright © Young Sideways, 2026. All right reserved.
+ ******************************************************************************/
+
+#ifndef _INI_SCHEMA_H_
+#define _INI_SCHEMA_H_
+
+#pragma once
+
+#pragma region --- INCLUDES ---
+
+#include <stddef.h>
+
+#include "ini.types.h"
+
+#pragma endregion
+
+#pragma region --- MACROS ---
+
+#define INI_SCHEMA_MAX_FIELDS 0xFFFEU //!< field indices are kept in 16 bits
+
+#if defined(__STDC_VERSION__) && __STDC_VERSION__ >= 201112L
+/**
+ *  @brief compile time check of the member type, evaluates to 0
+ */
+#   define _INI_FIELD_CHECK(type, member, ctype) (0U * sizeof(_Generic(((type*)0)->member, ctype: 1)))
+#else
+#   define _INI_FIELD_CHECK(type, member, ctype) 0U
+#endif
+
+#define _INI_FIELD(type, member, ctype, key, kind, def) \
+    { (key), offsetof(type, member) + _INI_FIELD_CHECK(type, member, ctype), (kind), { def } }
+
+/**
+ *  @brief field declarations of a static ini_field table
+ *  @param type   - struct type
+ *  @param member - struct member of the matching type (int, int64_t, double, bool, ini_string)
+ *  @param key    - property key
+ *  @param def    - value of the member, if the property isn't found
+ *  @note  string members receive views (valid until ini_destroy), def is a C string or NULL
+ */
+#define INI_FIELD_INT(type, member, key, def)    _INI_FIELD(type, member, int, key, INI_FIELD_TYPE_INT, .vint = (def))
+#define INI_FIELD_INT64(type, member, key, def)  _INI_FIELD(type, member, int64_t, key, INI_FIELD_TYPE_INT64, .vint64 = (def))
+#define INI_FIELD_DOUBLE(type, member, key, def) _INI_FIELD(type, member, double, key, INI_FIELD_TYPE_DOUBLE, .vdouble = (def))
+#define INI_FIELD_BOOL(type, member, key, def)   _INI_FIELD(type, member, bool, key, INI_FIELD_TYPE_BOOL, .vbool = (def))
+#define INI_FIELD_STRING(type, member, key, def) _INI_FIELD(type, member, ini_string, key, INI_FIELD_TYPE_STRING, .vstring = (def))
+
+/**
+ *  @brief compiles static field table, see ini_schema_compile
+ */
+#define INI_SCHEMA_COMPILE(fields, allocator) ini_schema_compile((fields), sizeof(fields) / sizeof(*(fields)), (allocator))
+
+#pragma endregion
+
+#pragma region --- TYPEDEFS ---
+
+typedef enum ini_field_type     ini_field_type;
+
+typedef struct ini_field        ini_field;
+typedef struct ini_schema_entry ini_schema_entry;
+typedef struct ini_schema       ini_schema;
+
+#pragma endregion
+
+#pragma region --- ENUMS ---
+
+enum ini_field_type {
+    INI_FIELD_TYPE_INT,    // int, as ini_to_int
+    INI_FIELD_TYPE_INT64,  // int64_t, as ini_to_int64
+    INI_FIELD_TYPE_DOUBLE, // double, as ini_to_double
+    INI_FIELD_TYPE_BOOL,   // bool, as ini_to_bool
+    INI_FIELD_TYPE_STRING  // ini_string view of INI_STRING value
+};
+
+#pragma endregion
+
+#pragma region --- STRUCTS ---
+
+/**
+ *  @brief struct member bound to a property, declared by INI_FIELD_* macros
+ */
+struct ini_field {
+    const char* key;     //!< property key
+    size_t offset;       //!< member offset
+    ini_field_type type; //!< member type
+    union {
+        int vint;
+        int64_t vint64;
+        double vdouble;
+        bool vbool;
+        const char* vstring;
+    } def;               //!< default value
+};
+
+/**
+ *  @brief key data of a field, computed once by ini_schema_compile
+ */
+struct ini_schema_entry {
+    ini_hash hash;         //!< key hash, the same as ini_property::hash
+    size_t key_length;     //!< key length
+    size_t default_length; //!< length of the default string
+};
+
+/**
+ *  @brief fill plan: perfect hash from a property key hash to its field
+ */
+struct ini_schema {
+    const ini_field* fields;   //!< field table, must outlive the schema
+    ini_schema_entry* entries; //!< key data by field
+    uint16_t* slots;           //!< field index + 1 by slot, 0 - no field
+    size_t count;              //!< count of fields
+    uint32_t seed;             //!< seed of the slot hash without collisions
+    unsigned shift;            //!< 32 - log2(count of slots)
+    size_t size;               //!< allocated bytes
+    ini_allocator allocator;   //!< memory of the schema
+};
+
+#pragma endregion
+
+#pragma region --- FUNCTIONS ---
+
+/**
+ *  @brief  builds fill plan of the field table
+ *  @param  fields    - field table, must outlive the schema
+ *  @param  count     - count of fields, up to INI_SCHEMA_MAX_FIELDS
+ *  @param  allocator - memory hooks, NULL - malloc/free
+ *  @retval           - schema, or NULL on allocation fail or duplicate keys
+ */
+ini_schema* ini_schema_compile(const ini_field* fields, size_t count, _NULLABLE const ini_allocator* allocator);
+
+/**
+ *  @brief releases schema
+ *  @param schema - schema, or NULL
+ */
+void ini_schema_destroy(ini_schema* schema);
+
+/**
+ *  @brief  fills struct with properties of the section in a single pass over them
+ *  @param  file    - ini file
+ *  @param  schema  - compiled schema
+ *  @param  section - dotted section name, NULL - root section
+ *  @param  out     - struct to fill, members without properties get their defaults
+ *  @retval         - false if the section isn't found (the struct gets defaults only)
+ */
+bool ini_schema_fill(const INI* file, const ini_schema* schema, _NULLABLE const char* section, void* out);
+
+#pragma endregion
+
+#endif // !_INI_SCHEMA_H_
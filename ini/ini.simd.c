@@ -0,0 +1,238 @@
+/*******************************************************************************
+ *  @file      ini.simd.c
+ *  @brief     Vectorized structural character scanner
+ *  @author    Young Sideways
+ *  @date      17.10.2026
+ *  @copyright © Young Sideways, 2026. All right reserved.
+ ******************************************************************************/
+
+#include "ini.simd.h"
+
+#pragma region --- INCLUDES ---
+
+#include <string.h>
+#include <stdbool.h>
+
+#include "ini.utils.h"
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#   define INI_SIMD_X86
+#   include <immintrin.h>
+#endif
+
+#ifdef _MSC_VER
+#   include <intrin.h>
+#endif
+
+#pragma endregion
+
+#pragma region --- MACROS ---
+
+#if defined(INI_SIMD_X86) && (defined(__GNUC__) || defined(__clang__))
+#   define TARGET(isa) __attribute__((target(isa)))
+#else
+#   define TARGET(isa)
+#endif
+
+#pragma endregion
+
+#pragma region --- CLASSIFIERS ---
+
+static uint64_t _classify_scalar(const char* block) {
+    uint64_t mask = 0U;
+    for (unsigned i = 0; i < INI_SCANNER_BLOCK_SIZE; i++)
+        switch (block[i])
+        {
+        case '\n': case '#': case ';': case '[': case ']': case '\\':
+            mask |= (uint64_t)1U << i;
+            break;
+        default:
+            break;
+        }
+    return mask;
+}
+
+#ifdef INI_SIMD_X86
+
+TARGET("sse2") static inline uint32_t _classify_sse2_16(const char* chunk) {
+    __m128i bytes = _mm_loadu_si128((const __m128i*)chunk);
+    __m128i found = _mm_or_si128(
+        _mm_or_si128(_mm_cmpeq_epi8(bytes, _mm_set1_epi8('\n')), _mm_cmpeq_epi8(bytes, _mm_set1_epi8('#'))),
+        _mm_or_si128(_mm_cmpeq_epi8(bytes, _mm_set1_epi8(';')),  _mm_cmpeq_epi8(bytes, _mm_set1_epi8('\\'))));
+    found = _mm_or_si128(found, _mm_or_si128(
+        _mm_cmpeq_epi8(bytes, _mm_set1_epi8('[')), _mm_cmpeq_epi8(bytes, _mm_set1_epi8(']'))));
+    return (uint32_t)_mm_movemask_epi8(found);
+}
+
+TARGET("sse2") static uint64_t _classify_sse2(const char* block) {
+    return (uint64_t)_classify_sse2_16(block) |
+           (uint64_t)_classify_sse2_16(block + 16) << 16 |
+           (uint64_t)_classify_sse2_16(block + 32) << 32 |
+           (uint64_t)_classify_sse2_16(block + 48) << 48;
+}
+
+TARGET("avx2") static inline uint32_t _classify_avx2_32(const char* chunk) {
+    __m256i bytes = _mm256_loadu_si256((const __m256i*)chunk);
+    __m256i found = _mm256_or_si256(
+        _mm256_or_si256(_mm256_cmpeq_epi8(bytes, _mm256_set1_epi8('\n')), _mm256_cmpeq_epi8(bytes, _mm256_set1_epi8('#'))),
+        _mm256_or_si256(_mm256_cmpeq_epi8(bytes, _mm256_set1_epi8(';')),  _mm256_cmpeq_epi8(bytes, _mm256_set1_epi8('\\'))));
+    found = _mm256_or_si256(found, _mm256_or_si256(
+        _mm256_cmpeq_epi8(bytes, _mm256_set1_epi8('[')), _mm256_cmpeq_epi8(bytes, _mm256_set1_epi8(']'))));
+    return (uint32_t)_mm256_movemask_epi8(found);
+}
+
+TARGET("avx2") static uint64_t _classify_avx2(const char* block) {
+    return (uint64_t)_classify_avx2_32(block) | (uint64_t)_classify_avx2_32(block + 32) << 32;
+}
+
+static bool _cpu_has_sse2(void) {
+#if defined(_M_X64) || defined(__x86_64__)
+    return true;
+#elif defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 1);
+    return (info[3] >> 26) & 1;
+#else
+    return __builtin_cpu_supports("sse2");
+#endif
+}
+
+static bool _cpu_has_avx2(void) {
+#ifdef _MSC_VER
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7)
+        return false;
+    __cpuid(info, 1);
+    if (!((info[2] >> 27) & 1) || (_xgetbv(0) & 0x6U) != 0x6U) // OS saves YMM registers
+        return false;
+    __cpuidex(info, 7, 0);
+    return (info[1] >> 5) & 1;
+#else
+    return __builtin_cpu_supports("avx2");
+#endif
+}
+
+#endif
+
+#pragma endregion
+
+#pragma region --- DISPATCH ---
+
+/**
+ *  @brief selected ini_simd_level, -1 until the first scanner resolves it
+ *  @note  accessed atomically: ini_open_parallel initializes scanners from several threads
+ */
+static volatile long _level = -1;
+
+#ifdef _MSC_VER
+
+static inline long _load_level(void) {
+    return _InterlockedOr(&_level, 0);
+}
+
+static inline void _store_level(long level) {
+    _InterlockedExchange(&_level, level);
+}
+
+static inline void _init_level(long level) {
+    _InterlockedCompareExchange(&_level, level, -1);
+}
+
+#else
+
+static inline long _load_level(void) {
+    return __atomic_load_n(&_level, __ATOMIC_ACQUIRE);
+}
+
+static inline void _store_level(long level) {
+    __atomic_store_n(&_level, level, __ATOMIC_RELEASE);
+}
+
+static inline void _init_level(long level) {
+    long expected = -1;
+    __atomic_compare_exchange_n(&_level, &expected, level, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE);
+}
+
+#endif
+
+/**
+ *  @brief best implementation supported by the CPU, but not above level
+ */
+static ini_simd_level _supported(ini_simd_level level) {
+#ifdef INI_SIMD_X86
+    if (level >= INI_SIMD_AVX2 && _cpu_has_avx2())
+        return INI_SIMD_AVX2;
+    if (level >= INI_SIMD_SSE2 && _cpu_has_sse2())
+        return INI_SIMD_SSE2;
+#endif
+    (void)level;
+    return INI_SIMD_SCALAR;
+}
+
+static ini_scanner_classify _classifier(ini_simd_level level) {
+    switch (level)
+    {
+#ifdef INI_SIMD_X86
+    case INI_SIMD_AVX2:
+        return _classify_avx2;
+    case INI_SIMD_SSE2:
+        return _classify_sse2;
+#endif
+    default:
+        return _classify_scalar;
+    }
+}
+
+ini_simd_level ini_simd_select(ini_simd_level level) {
+    level = _supported(level);
+    _store_level((long)level);
+    return level;
+}
+
+#pragma endregion
+
+#pragma region --- FUNCTIONS ---
+
+void ini_scanner_init(ini_scanner* scanner, const char* begin, const char* end) {
+    scanner->begin = begin;
+    scanner->end   = end;
+    scanner->block = NULL;
+    scanner->mask  = 0U;
+
+    // racing first scanners store the same level, an explicit ini_simd_select is kept
+    long level = _load_level();
+    if (level < 0) {
+        _init_level((long)_supported(INI_SIMD_AVX2));
+        level = _load_level();
+    }
+    scanner->classify = _classifier((ini_simd_level)level);
+}
+
+const char* ini_scanner_next(ini_scanner* scanner, const char* from) {
+    const char* end = scanner->end;
+
+    while (from < end) {
+        const char* block = scanner->block;
+        if (!block || from < block || from >= block + INI_SCANNER_BLOCK_SIZE) {
+            block = scanner->begin + ((size_t)(from - scanner->begin) & ~(size_t)(INI_SCANNER_BLOCK_SIZE - 1U));
+            if ((size_t)(end - block) >= INI_SCANNER_BLOCK_SIZE)
+                scanner->mask = scanner->classify(block);
+            else {
+                // the tail is padded with zeroes, so nothing is read past the end
+                char tail[INI_SCANNER_BLOCK_SIZE] = { 0 };
+                memcpy(tail, block, (size_t)(end - block));
+                scanner->mask = scanner->classify(tail);
+            }
+            scanner->block = block;
+        }
+
+        uint64_t mask = scanner->mask & (~(uint64_t)0U << (size_t)(from - block));
+        if (mask)
+            return block + bit_ctz64(mask);
+        from = block + INI_SCANNER_BLOCK_SIZE;
+    }
+    return end;
+}
+
+#pragma endregion
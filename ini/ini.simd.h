@@ -0,0 +1,87 @@
+/*******************************************************************************
+ *  @file      ini.simd.h
+ *  @brief     Vectorized structural character scanner
+ *  @author    Young Sideways
+ *  @date      17.10.2026
+ *  @copyright © Young Sideways, 2026. All right reserved.
+ ******************************************************************************/
+
+#ifndef _INI_SIMD_H_
+#define _INI_SIMD_H_
+
+#pragma once
+
+#pragma region --- INCLUDES ---
+
+#include <stddef.h>
+#include <stdint.h>
+
+#pragma endregion
+
+#pragma region --- MACROS ---
+
+#define INI_SCANNER_BLOCK_SIZE 64U //!< bytes classified at once (one bit per byte)
+
+#pragma endregion
+
+#pragma region --- TYPEDEFS ---
+
+typedef enum ini_simd_level ini_simd_level;
+
+typedef struct ini_scanner  ini_scanner;
+
+typedef uint64_t (*ini_scanner_classify)(const char* block);
+
+#pragma endregion
+
+#pragma region --- ENUMS ---
+
+enum ini_simd_level {
+    INI_SIMD_SCALAR = 0x0U, // class table lookup, byte by byte
+    INI_SIMD_SSE2   = 0x1U, // 4 x 16 bytes
+    INI_SIMD_AVX2   = 0x2U  // 2 x 32 bytes
+};
+
+#pragma endregion
+
+#pragma region --- STRUCTS ---
+
+/**
+ *  @brief structural index over a buffer: '\n', '#', ';', '[', ']', '\\'
+ *  @note  every 64-byte block is classified once into a bitmask,
+ *         so the lexer jumps from one structural character to the next
+ */
+struct ini_scanner {
+    const char* begin; //!< buffer start, blocks are counted from it
+    const char* end;   //!< buffer end
+    const char* block; //!< classified block (NULL - nothing classified yet)
+    uint64_t mask;     //!< structural bits of the block
+    ini_scanner_classify classify; //!< implementation selected when the scanner was initialized
+};
+
+#pragma endregion
+
+#pragma region --- FUNCTIONS ---
+
+/**
+ *  @brief  selects the scanner implementation for the whole process
+ *  @param  level - best allowed implementation
+ *  @retval       - best implementation supported by the CPU, but not above level
+ *  @note   by default the best supported one is picked by the first ini_scanner_init,
+ *          scanners that are already initialized keep their implementation
+ */
+ini_simd_level ini_simd_select(ini_simd_level level);
+
+void ini_scanner_init(ini_scanner* scanner, const char* begin, const char* end);
+
+/**
+ *  @brief  finds the first structural character at or after from
+ *  @param  scanner - scanner
+ *  @param  from    - position inside the buffer
+ *  @retval         - structural character position, or end of the buffer
+ */
+const char* ini_scanner_next(ini_scanner* scanner, const char* from);
+
+#pragma endregion
+
+#endif // !_INI_SIMD_H_
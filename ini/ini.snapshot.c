@@ -0,0 +1,271 @@
+/*******************************************************************************
+ *  @file      ini.snapshot.c
+ *  @brief     Flat binary image of a parsed ini file
+ *  @author    Young Sideways
+ *  @date      17.10.2026
+ *  @copyright © Young Sideways, 2026. All right reserved.
+ ******************************************************************************/
+
+#include "ini.snapshot.h"
+
+#pragma region --- INCLUDES ---
+
+#include "ini.parser.h"
+
+#pragma endregion
+
+#pragma region --- MACROS ---
+
+#define OFFSET(image, offset) ((const char*)(image) + (offset))
+
+#pragma endregion
+
+#pragma region --- INTERNAL ---
+
+/**
+ *  @brief image under construction
+ */
+typedef struct ini_snapshot_writer {
+    uint8_t* image;                    //!< image up to the pilots
+    ini_snapshot_header* header;       //!< image header
+    ini_snapshot_section* sections;    //!< section records
+    ini_snapshot_property* properties; //!< property records
+    uint32_t* slots;                   //!< property record of every slot
+    uint64_t* keys;                    //!< table key of every property record (allocator memory)
+    size_t strings;                    //!< next free byte of the string pool
+} ini_snapshot_writer;
+
+/**
+ *  @brief  copies string to the pool
+ *  @retval - offset of the string
+ */
+static uint64_t _string_write(ini_snapshot_writer* writer, const char* data, size_t size) {
+    size_t offset = writer->strings;
+    if (size)
+        memcpy(writer->image + offset, data, size);
+    writer->image[offset + size] = '\0';
+    writer->strings += size + 1U;
+    return offset;
+}
+
+/**
+ *  @brief  checks that the span lies inside the image
+ */
+static inline bool _in_image(const ini_snapshot_header* image, uint64_t offset, uint64_t size) {
+    return offset <= image->size && size <= image->size - offset;
+}
+
+#pragma endregion
+
+#pragma region --- FUNCTIONS ---
+
+bool ini_snapshot_write(const INI* file, FILE* stream) {
+    if (!file || !stream)
+        return false;
+
+    // an image loaded from a snapshot is written back as is
+    if (file->snapshot) {
+        const ini_snapshot_header* header = file->snapshot;
+        return fwrite(header, 1U, (size_t)header->size, stream) == (size_t)header->size;
+    }
+
+    // first pass: sizes of all parts
+    size_t section_count = 0U, property_count = 0U, strings = 0U;
+    size_t cursor = 0U;
+    for (const ini_section* section; (section = ini_table_next(&file->sections, &cursor)); ) {
+        section_count++;
+        property_count += section->properties.size;
+        strings        += ini_section_name_length(section) + 1U;
+
+        size_t inner = 0U;
+        for (const ini_property* property; (property = ini_table_next(&section->properties, &inner)); ) {
+            ini_value value = ini_value_resolve(ini_value_unpack(&property->value));
+            strings += property->key.length + 1U;
+            if (value.type == INI_STRING)
+                strings += value.vstring.length + 1U;
+        }
+    }
+    if (property_count > INI_PHASH_MAX_COUNT)
+        return false;
+
+    // pilots go last: their count is known once the table is built from the written names
+    size_t offset_sections   = sizeof(ini_snapshot_header);
+    size_t offset_properties = offset_sections + section_count * sizeof(ini_snapshot_section);
+    size_t offset_slots      = offset_properties + property_count * sizeof(ini_snapshot_property);
+    size_t offset_strings    = offset_slots + property_count * sizeof(uint32_t);
+    size_t offset_pilots     = (offset_strings + strings + 3U) & ~(size_t)3U;
+
+    const ini_allocator* allocator = &file->arena.allocator;
+    uint8_t* image = allocator->alloc(offset_pilots, allocator->user);
+    uint64_t* keys = property_count ? allocator->alloc(property_count * sizeof(uint64_t), allocator->user) : NULL;
+    if (!image || (property_count && !keys)) {
+        if (image)
+            allocator->free(image, offset_pilots, allocator->user);
+        return false;
+    }
+    memset(image, 0, offset_pilots);
+
+    ini_snapshot_writer writer = {
+        .image      = image,
+        .header     = (ini_snapshot_header*)image,
+        .sections   = (ini_snapshot_section*)(image + offset_sections),
+        .properties = (ini_snapshot_property*)(image + offset_properties),
+        .slots      = (uint32_t*)(image + offset_slots),
+        .keys       = keys,
+        .strings    = offset_strings
+    };
+
+    ini_snapshot_header* header = writer.header;
+    memcpy(header->magic, INI_SNAPSHOT_MAGIC, sizeof(header->magic));
+    header->version        = INI_SNAPSHOT_VERSION;
+    header->endian         = INI_SNAPSHOT_ENDIAN;
+    header->section_count  = (uint32_t)section_count;
+    header->property_count = (uint32_t)property_count;
+    header->sections       = offset_sections;
+    header->properties     = offset_properties;
+    header->slots          = offset_slots;
+    header->pilots         = offset_pilots;
+    header->strings        = offset_strings;
+
+    // second pass: records and strings
+    uint32_t section_index = 0U, property_index = 0U;
+    cursor = 0U;
+    for (const ini_section* section; (section = ini_table_next(&file->sections, &cursor)); section_index++) {
+        ini_snapshot_section* record = &writer.sections[section_index];
+        size_t length = ini_section_name_length(section);
+        record->name        = writer.strings;
+        record->name_length = (uint32_t)length;
+        ini_section_name_write((char*)image + writer.strings, section);
+        image[writer.strings + length] = '\0';
+        writer.strings += length + 1U;
+        uint64_t name = ini_phash_key(OFFSET(image, record->name), length, true);
+
+        size_t inner = 0U;
+        for (const ini_property* property; (property = ini_table_next(&section->properties, &inner)); property_index++) {
+            // values of a lazy file are typed, but not cached: the file is const here
+            ini_value value = ini_value_resolve(ini_value_unpack(&property->value));
+            ini_snapshot_property* item = &writer.properties[property_index];
+            item->section    = section_index;
+            item->key        = _string_write(&writer, property->key.data, property->key.length);
+            item->key_length = (uint32_t)property->key.length;
+            item->type       = (uint32_t)value.type;
+            switch (value.type)
+            {
+            case INI_INT:
+                item->vint = value.vint;
+                break;
+            case INI_INT64:
+                item->vint = value.vint64;
+                break;
+            case INI_BOOL:
+                item->vint = value.vbool;
+                break;
+            case INI_DOUBLE:
+                item->vdouble = value.vdouble;
+                break;
+            case INI_STRING:
+                item->vstring       = _string_write(&writer, value.vstring.data, value.vstring.length);
+                item->string_length = (uint32_t)value.vstring.length;
+                break;
+            default:
+                break;
+            }
+            writer.keys[property_index] = ini_phash_pair(name, ini_phash_key(property->key.data, property->key.length, false));
+        }
+    }
+
+    // the table: pilots from a scratch arena, slots right in the image
+    ini_arena scratch;
+    ini_arena_init(&scratch, allocator);
+    ini_phash phash = { .seed = 0U, .count = 0U, .bucket_count = 0U, .pilots = NULL };
+    bool built = !property_count || ini_phash_build(&phash, keys, (uint32_t)property_count, &scratch);
+    if (built) {
+        for (uint32_t i = 0; i < property_count; i++)
+            writer.slots[ini_phash_slot(&phash, keys[i])] = i;
+        header->seed         = phash.seed;
+        header->bucket_count = phash.bucket_count;
+        header->size         = offset_pilots + (uint64_t)phash.bucket_count * sizeof(uint32_t);
+    }
+
+    bool written = built && fwrite(image, 1U, offset_pilots, stream) == offset_pilots &&
+                   fwrite(phash.pilots, sizeof(uint32_t), phash.bucket_count, stream) == phash.bucket_count;
+    ini_arena_release(&scratch);
+    if (keys)
+        allocator->free(keys, property_count * sizeof(uint64_t), allocator->user);
+    allocator->free(image, offset_pilots, allocator->user);
+    return written;
+}
+
+const ini_snapshot_header* ini_snapshot_check(const void* data, size_t size) {
+    const ini_snapshot_header* header = data;
+    if (!data || size < sizeof(ini_snapshot_header) || ((uintptr_t)data & 7U))
+        return NULL;
+    if (memcmp(header->magic, INI_SNAPSHOT_MAGIC, sizeof(header->magic)) ||
+        header->version != INI_SNAPSHOT_VERSION || header->endian != INI_SNAPSHOT_ENDIAN || header->size != size)
+        return NULL;
+
+    // a table for every property and every array inside the image
+    if ((header->property_count && !header->bucket_count) || (header->pilots & 3U) || (header->slots & 3U) ||
+        !_in_image(header, header->sections, (uint64_t)header->section_count * sizeof(ini_snapshot_section)) ||
+        !_in_image(header, header->properties, (uint64_t)header->property_count * sizeof(ini_snapshot_property)) ||
+        !_in_image(header, header->pilots, (uint64_t)header->bucket_count * sizeof(uint32_t)) ||
+        !_in_image(header, header->slots, (uint64_t)header->property_count * sizeof(uint32_t)) ||
+        !_in_image(header, header->strings, 0U))
+        return NULL;
+    return header;
+}
+
+const ini_snapshot_property* ini_snapshot_find(const ini_snapshot_header* image, const char* section, size_t section_size,
+                                               const char* key, size_t key_size) {
+    if (!image->property_count)
+        return NULL;
+
+    const ini_snapshot_section* sections = (const ini_snapshot_section*)OFFSET(image, image->sections);
+    const ini_snapshot_property* properties = (const ini_snapshot_property*)OFFSET(image, image->properties);
+    const uint32_t* slots = (const uint32_t*)OFFSET(image, image->slots);
+
+    // a single probe, the record is compared with the names as the names may be out of the image
+    ini_phash phash = { .seed = image->seed, .count = image->property_count, .bucket_count = image->bucket_count,
+                        .pilots = (uint32_t*)OFFSET(image, image->pilots) };
+    uint32_t slot = ini_phash_slot(&phash, ini_phash_pair(ini_phash_key(section, section_size, true), ini_phash_key(key, key_size, false)));
+    if (slot >= image->property_count || slots[slot] >= image->property_count)
+        return NULL;
+    const ini_snapshot_property* record = &properties[slots[slot]];
+    if (record->key_length != key_size || !_in_image(image, record->key, key_size) ||
+        memcmp(OFFSET(image, record->key), key, key_size) || record->section >= image->section_count)
+        return NULL;
+    const ini_snapshot_section* owner = &sections[record->section];
+    if (owner->name_length != section_size || !_in_image(image, owner->name, section_size) ||
+        !mem_iequals(OFFSET(image, owner->name), section, section_size))
+        return NULL;
+    return record;
+}
+
+ini_value ini_snapshot_value(const ini_snapshot_header* image, const ini_snapshot_property* record) {
+    switch (record->type)
+    {
+    case INI_INT:
+        return (ini_value){ .type = INI_INT, .vint = (int)record->vint };
+    case INI_INT64:
+        return (ini_value){ .type = INI_INT64, .vint64 = record->vint };
+    case INI_BOOL:
+        return (ini_value){ .type = INI_BOOL, .vbool = record->vint != 0 };
+    case INI_DOUBLE:
+        return (ini_value){ .type = INI_DOUBLE, .vdouble = record->vdouble };
+    case INI_STRING:
+        if (!_in_image(image, record->vstring, record->string_length))
+            break;
+        return (ini_value){ .type = INI_STRING, .vstring = { OFFSET(image, record->vstring), record->string_length } };
+    default:
+        break;
+    }
+    return ini_value_default(INI_NONE);
+}
+
+ini_value ini_snapshot_get_value(const ini_snapshot_header* image, const char* section, size_t section_size,
+                                 const char* key, size_t key_size) {
+    const ini_snapshot_property* record = ini_snapshot_find(image, section, section_size, key, key_size);
+    return record ? ini_snapshot_value(image, record) : ini_value_default(INI_NONE);
+}
+
+#pragma endregion
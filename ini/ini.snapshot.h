@@ -0,0 +1,134 @@
+/*******************************************************************************
+ *  @file      ini.snapshot.h
+ *  @brief     Flat binary image of a parsed ini file
+ *  @author    Young Sideways
+ *  @date      17.10.2026
+ *  @copyright © Young Sideways, 2026. All right reserved.
+ ******************************************************************************/
+
+#ifndef _INI_SNAPSHOT_H_
+#define _INI_SNAPSHOT_H_
+
+#pragma once
+
+#pragma region --- INCLUDES ---
+
+#include "ini.types.h"
+
+#pragma endregion
+
+#pragma region --- MACROS ---
+
+#define INI_SNAPSHOT_MAGIC   "YSINISNP"  //!< first 8 bytes of the image
+#define INI_SNAPSHOT_VERSION 2U          //!< bumped on every layout change
+#define INI_SNAPSHOT_ENDIAN  0x01020304U //!< written natively, images of another byte order are rejected
+
+#pragma endregion
+
+#pragma region --- TYPEDEFS ---
+
+typedef struct ini_snapshot_header   ini_snapshot_header;
+typedef struct ini_snapshot_section  ini_snapshot_section;
+typedef struct ini_snapshot_property ini_snapshot_property;
+
+#pragma endregion
+
+#pragma region --- STRUCTS ---
+
+/**
+ *  @brief  image layout: header, sections, properties, slots, strings, pilots
+ *  @note   every reference is an offset from the image start, so the image is
+ *          queried right in the mapping. Properties are found by the table of
+ *          ini_freeze: an ini_phash over dotted section names paired with keys,
+ *          a slot keeps the property record index
+ */
+struct ini_snapshot_header {
+    char magic[8];               //!< INI_SNAPSHOT_MAGIC without '\0'
+    uint32_t version;            //!< INI_SNAPSHOT_VERSION
+    uint32_t endian;             //!< INI_SNAPSHOT_ENDIAN
+    uint64_t size;               //!< image size in bytes
+
+    uint32_t section_count;      //!< count of section records
+    uint32_t property_count;     //!< count of property records and slots
+    uint64_t seed;               //!< ini_phash::seed of the property table
+    uint32_t bucket_count;       //!< ini_phash::bucket_count of the property table
+    uint32_t reserved;           //!< 0
+
+    uint64_t sections;           //!< offset of ini_snapshot_section[section_count]
+    uint64_t properties;         //!< offset of ini_snapshot_property[property_count]
+    uint64_t pilots;             //!< offset of uint32_t[bucket_count]
+    uint64_t slots;              //!< offset of uint32_t[property_count]
+    uint64_t strings;            //!< offset of null-terminated strings
+};
+
+struct ini_snapshot_section {
+    uint64_t name;               //!< offset of the full dotted name ("settings.com1")
+    uint32_t name_length;        //!< full name length
+    uint32_t reserved;           //!< 0
+};
+
+struct ini_snapshot_property {
+    uint32_t section;            //!< index of the section record
+    uint32_t type;               //!< ini_value_type
+    uint64_t key;                //!< offset of the key
+    uint32_t key_length;         //!< key length
+    uint32_t string_length;      //!< length of INI_STRING value
+    union {
+        int64_t vint;            //!< INI_INT, INI_INT64 or INI_BOOL value
+        double vdouble;          //!< INI_DOUBLE value
+        uint64_t vstring;        //!< offset of INI_STRING value
+    };
+};
+
+#pragma endregion
+
+#pragma region --- FUNCTIONS ---
+
+/**
+ *  @brief  writes image of the file
+ *  @param  file   - parsed ini file
+ *  @param  stream - binary output stream
+ *  @retval        - false on allocation or write fail
+ */
+bool ini_snapshot_write(const INI* file, FILE* stream);
+
+/**
+ *  @brief  checks image header, records are not visited
+ *  @param  data - image
+ *  @param  size - image size
+ *  @retval      - image header, or NULL if it isn't a valid image of this version and byte order
+ */
+const ini_snapshot_header* ini_snapshot_check(const void* data, size_t size);
+
+/**
+ *  @brief  finds property record right in the image
+ *  @param  image        - checked image
+ *  @param  section      - dotted section name, case insensitive
+ *  @param  section_size - name length
+ *  @param  key          - property key
+ *  @param  key_size     - key length
+ *  @retval              - record, or NULL if not found
+ */
+const ini_snapshot_property* ini_snapshot_find(const ini_snapshot_header* image, const char* section, size_t section_size,
+                                               const char* key, size_t key_size);
+
+/**
+ *  @brief  value of a record found by ini_snapshot_find, strings point into the image
+ */
+ini_value ini_snapshot_value(const ini_snapshot_header* image, const ini_snapshot_property* record);
+
+/**
+ *  @brief  finds property value right in the image
+ *  @param  image        - checked image
+ *  @param  section      - dotted section name, case insensitive
+ *  @param  section_size - name length
+ *  @param  key          - property key
+ *  @param  key_size     - key length
+ *  @retval              - property value (strings point into the image), or INI_NONE value if not found
+ */
+ini_value ini_snapshot_get_value(const ini_snapshot_header* image, const char* section, size_t section_size,
+                                 const char* key, size_t key_size);
+
+#pragma endregion
+
+#endif // !_INI_SNAPSHOT_H_
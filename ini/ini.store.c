@@ -0,0 +1,48 @@
+/*******************************************************************************
+ *  @file      ini.store.c
+ *  @brief     Dense insertion ordered array of fixed size entries
+ *  @author    Young Sideways
+ *  @date      17.10.2026
+ *  @copyright © Young Sideways, 2026. All right reserved.
+ ******************************************************************************/
+
+#include "ini.store.h"
+
+#pragma region --- INCLUDES ---
+
+#include <string.h>
+
+#pragma endregion
+
+#pragma region --- MACROS ---
+
+#define INI_STORE_MAX_COUNT (UINT32_MAX - (1U << INI_STORE_FIRST_SHIFT)) //!< position of the last entry fits 32 bits
+
+#pragma endregion
+
+#pragma region --- FUNCTIONS ---
+
+void ini_store_init(ini_store* store, size_t entry_size) {
+    memset(store->pages, 0, sizeof(store->pages));
+    store->count      = 0U;
+    store->entry_size = entry_size;
+}
+
+void* ini_store_push(ini_store* store, ini_arena* arena, ini_store_index* index) {
+    if (store->count >= INI_STORE_MAX_COUNT)
+        return NULL;
+
+    // a new page starts when the position reaches the next power of two
+    uint32_t position = store->count + (1U << INI_STORE_FIRST_SHIFT);
+    unsigned page = bit_msb32(position) - INI_STORE_FIRST_SHIFT;
+    if (!store->pages[page]) {
+        size_t count = (size_t)1U << (page + INI_STORE_FIRST_SHIFT);
+        if (!(store->pages[page] = ini_arena_alloc(arena, count * store->entry_size)))
+            return NULL;
+    }
+
+    *index = store->count++;
+    return ini_store_at(store, *index);
+}
+
+#pragma endregion
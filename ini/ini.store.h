@@ -0,0 +1,86 @@
+/*******************************************************************************
+ *  @file      ini.store.h
+ *  @brief     Dense insertion ordered array of fixed size entries
+ *  @author    Young Sideways
+ *  @date      17.10.2026
+ *  @copyright © Young Sideways, 2026. All right reserved.
+ ******************************************************************************/
+
+#ifndef _INI_STORE_H_
+#define _INI_STORE_H_
+
+#pragma once
+
+#pragma region --- INCLUDES ---
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "ini.arena.h"
+#include "ini.utils.h"
+
+#pragma endregion
+
+#pragma region --- MACROS ---
+
+#define INI_STORE_FIRST_SHIFT 4U  //!< the first page keeps 16 entries, every next one is twice larger
+#define INI_STORE_PAGES       28U //!< pages of UINT32_MAX entries
+
+#pragma endregion
+
+#pragma region --- TYPEDEFS ---
+
+typedef uint32_t         ini_store_index;
+typedef struct ini_store ini_store;
+
+#pragma endregion
+
+#pragma region --- STRUCTS ---
+
+/**
+ *  @brief  entries in the order of ini_store_push, addressed by index
+ *  @note   entries are kept in pages of 16, 32, 64... entries allocated from the arena,
+ *          so they never move: pointers stay valid and a walk by index reads memory
+ *          linearly, hopping only between a few pages
+ */
+struct ini_store {
+    uint8_t* pages[INI_STORE_PAGES]; //!< page k keeps (16 << k) entries, NULL - not allocated yet
+    ini_store_index count;           //!< count of entries
+    size_t entry_size;               //!< size of an entry
+};
+
+#pragma endregion
+
+#pragma region --- FUNCTIONS ---
+
+/**
+ *  @brief initializes empty store, no memory is allocated
+ *  @param store      - store
+ *  @param entry_size - size of an entry (multiple of its alignment, as sizeof)
+ */
+void ini_store_init(ini_store* store, size_t entry_size);
+
+/**
+ *  @brief  appends uninitialized entry
+ *  @param  store - store
+ *  @param  arena - memory for pages
+ *  @param  index - index of the new entry
+ *  @retval       - entry, or NULL on allocation fail
+ */
+void* ini_store_push(ini_store* store, ini_arena* arena, ini_store_index* index);
+
+/**
+ *  @brief  entry by index
+ *  @param  store - store
+ *  @param  index - index below count
+ */
+static inline void* ini_store_at(const ini_store* store, ini_store_index index) {
+    uint32_t position = index + (1U << INI_STORE_FIRST_SHIFT);
+    unsigned page = bit_msb32(position);
+    return store->pages[page - INI_STORE_FIRST_SHIFT] + (size_t)(position - (1U << page)) * store->entry_size;
+}
+
+#pragma endregion
+
+#endif // !_INI_STORE_H_
@@ -0,0 +1,243 @@
+/*******************************************************************************
+ *  @file      ini.table.c
+ *  @brief     Flat open-addressing hash table (swiss table layout)
+ *  @author    Young Sideways
+ *  @date      17.10.2026
+ *  @copyright © Young Sideways, 2026. All right reserved.
+ ******************************************************************************/
+
+#include "ini.table.h"
+
+#pragma region --- INCLUDES ---
+
+#include <string.h>
+
+#include "ini.utils.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#   define INI_TABLE_SSE2
+#   include <emmintrin.h>
+#endif
+
+#pragma endregion
+
+#pragma region --- MACROS ---
+
+#define CTRL_EMPTY   ((uint8_t)0x80U) //!< never used slot, stops probing
+#define CTRL_DELETED ((uint8_t)0xFEU) //!< freed slot, probing goes on
+
+#define H1(hash)     ((size_t)(hash))            //!< start position
+#define H2(hash)     ((uint8_t)((hash) >> 25))   //!< 7 bits kept in the control byte
+
+#pragma endregion
+
+#pragma region --- INTERNAL ---
+
+/**
+ *  @brief  bitmask of group control bytes equal to value
+ *  @param  group - INI_TABLE_GROUP_WIDTH control bytes
+ *  @param  value - control byte
+ */
+static inline uint32_t _group_match(const uint8_t* group, uint8_t value) {
+#ifdef INI_TABLE_SSE2
+    __m128i ctrl = _mm_loadu_si128((const __m128i*)group);
+    return (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(ctrl, _mm_set1_epi8((char)value)));
+#else
+    uint32_t mask = 0U;
+    for (unsigned i = 0; i < INI_TABLE_GROUP_WIDTH; i++)
+        mask |= (uint32_t)(group[i] == value) << i;
+    return mask;
+#endif
+}
+
+/**
+ *  @brief bitmask of empty or deleted slots (both have the high bit set)
+ *  @param group - INI_TABLE_GROUP_WIDTH control bytes
+ */
+static inline uint32_t _group_match_free(const uint8_t* group) {
+#ifdef INI_TABLE_SSE2
+    return (uint32_t)_mm_movemask_epi8(_mm_loadu_si128((const __m128i*)group));
+#else
+    uint32_t mask = 0U;
+    for (unsigned i = 0; i < INI_TABLE_GROUP_WIDTH; i++)
+        mask |= (uint32_t)(group[i] >> 7) << i;
+    return mask;
+#endif
+}
+
+static inline void _set_ctrl(uint8_t* ctrl, size_t capacity, size_t index, uint8_t value) {
+    ctrl[index] = value;
+    if (index < INI_TABLE_GROUP_WIDTH)
+        ctrl[capacity + index] = value; // mirrored head, so any group load stays in bounds
+}
+
+static ini_table_slot* _find(const ini_store* store, const uint8_t* ctrl, ini_table_slot* slots, size_t capacity,
+                             ini_table_hash hash, ini_table_match match, const void* key) {
+    size_t mask = capacity - 1U;
+    size_t pos  = H1(hash) & mask;
+
+    // triangular probing visits every group once
+    for (size_t step = 0U; step <= capacity; ) {
+        const uint8_t* group = ctrl + pos;
+        for (uint32_t found = _group_match(group, H2(hash)); found; found &= found - 1U) {
+            ini_table_slot* slot = &slots[(pos + bit_ctz32(found)) & mask];
+            if (slot->hash == hash && match(ini_store_at(store, slot->index), key))
+                return slot;
+        }
+        if (_group_match(group, CTRL_EMPTY))
+            return NULL;
+        step += INI_TABLE_GROUP_WIDTH;
+        pos = (pos + step) & mask;
+    }
+    return NULL;
+}
+
+/**
+ *  @brief  puts item to the first free slot of its probe sequence
+ *  @retval - true if an empty (not deleted) slot was taken
+ */
+static bool _place(uint8_t* ctrl, ini_table_slot* slots, size_t capacity, ini_table_hash hash, ini_store_index entry) {
+    size_t mask = capacity - 1U;
+    size_t pos  = H1(hash) & mask;
+
+    uint32_t found;
+    for (size_t step = 0U; !(found = _group_match_free(ctrl + pos)); ) {
+        step += INI_TABLE_GROUP_WIDTH;
+        pos = (pos + step) & mask;
+    }
+
+    size_t index = (pos + bit_ctz32(found)) & mask;
+    bool empty = ctrl[index] == CTRL_EMPTY;
+    _set_ctrl(ctrl, capacity, index, H2(hash));
+    slots[index].hash = hash;
+    slots[index].index = entry;
+    return empty;
+}
+
+/**
+ *  @brief moves up to count slots of the old table to the current one
+ */
+static void _drain(ini_table* table, size_t count) {
+    for (; table->old_ctrl && count; count--) {
+        size_t index = table->migrated++;
+        if (!(table->old_ctrl[index] & 0x80U)) {
+            ini_table_slot* slot = &table->old_slots[index];
+            if (_place(table->ctrl, table->slots, table->capacity, slot->hash, slot->index))
+                table->used++;
+            _set_ctrl(table->old_ctrl, table->old_capacity, index, CTRL_DELETED);
+        }
+        if (table->migrated == table->old_capacity) {
+            table->old_ctrl     = NULL;
+            table->old_slots    = NULL;
+            table->old_capacity = 0U;
+            table->migrated     = 0U;
+        }
+    }
+}
+
+static bool _grow(ini_table* table, ini_arena* arena) {
+    // previous resize must be finished before the next one starts
+    _drain(table, SIZE_MAX);
+
+    // mostly deleted slots are purged by a rehash of the same size, so remove/insert cycles don't grow the table
+    size_t capacity = table->capacity;
+    if ((float)(table->size + 1U) > (float)table->capacity * HT_MAX_LOAD_FACTOR * 0.5f)
+        capacity = HT_SIZE_GROWTH(table->capacity);
+    if (capacity < INI_TABLE_GROUP_WIDTH)
+        capacity = INI_TABLE_GROUP_WIDTH;
+
+    uint8_t* ctrl = ini_arena_alloc(arena, capacity + INI_TABLE_GROUP_WIDTH);
+    ini_table_slot* slots = ini_arena_alloc(arena, capacity * sizeof(ini_table_slot));
+    if (!ctrl || !slots)
+        return false;
+    memset(ctrl, CTRL_EMPTY, capacity + INI_TABLE_GROUP_WIDTH);
+
+    // old storage stays in the arena: total waste is bounded by the final table size
+    if (table->capacity) {
+        table->old_ctrl     = table->ctrl;
+        table->old_slots    = table->slots;
+        table->old_capacity = table->capacity;
+        table->migrated     = 0U;
+    }
+    table->ctrl     = ctrl;
+    table->slots    = slots;
+    table->capacity = capacity;
+    table->used     = 0U;
+    return true;
+}
+
+#pragma endregion
+
+#pragma region --- FUNCTIONS ---
+
+void ini_table_init(ini_table* table, const ini_store* store) {
+    memset(table, 0, sizeof(ini_table));
+    table->store = store;
+}
+
+void* ini_table_find(const ini_table* table, ini_table_hash hash, ini_table_match match, const void* key) {
+    if (!table->capacity)
+        return NULL;
+
+    ini_table_slot* slot = _find(table->store, table->ctrl, table->slots, table->capacity, hash, match, key);
+    if (!slot && table->old_ctrl)
+        slot = _find(table->store, table->old_ctrl, table->old_slots, table->old_capacity, hash, match, key);
+    return slot ? ini_store_at(table->store, slot->index) : NULL;
+}
+
+void ini_table_prefetch(const ini_table* table, ini_table_hash hash) {
+    if (!table->capacity)
+        return;
+
+    // an item is almost always found in the first group, the old table is left alone
+    size_t pos = H1(hash) & (table->capacity - 1U);
+    mem_prefetch(table->ctrl + pos);
+    mem_prefetch(table->slots + pos);
+}
+
+bool ini_table_insert(ini_table* table, ini_arena* arena, ini_table_hash hash, ini_store_index index) {
+    if ((float)(table->used + 1U) > (float)table->capacity * HT_MAX_LOAD_FACTOR)
+        if (!_grow(table, arena))
+            return false;
+
+    // a group per insertion drains the old table long before the new one fills up
+    _drain(table, INI_TABLE_GROUP_WIDTH);
+
+    if (_place(table->ctrl, table->slots, table->capacity, hash, index))
+        table->used++;
+    table->size++;
+    return true;
+}
+
+void* ini_table_remove(ini_table* table, ini_table_hash hash, ini_table_match match, const void* key) {
+    if (!table->capacity)
+        return NULL;
+
+    // the slot stays deleted (not empty): probe sequences of other items go through it
+    void* item = NULL;
+    ini_table_slot* slot = _find(table->store, table->ctrl, table->slots, table->capacity, hash, match, key);
+    if (slot)
+        _set_ctrl(table->ctrl, table->capacity, (size_t)(slot - table->slots), CTRL_DELETED);
+    else if (table->old_ctrl && (slot = _find(table->store, table->old_ctrl, table->old_slots, table->old_capacity, hash, match, key)))
+        _set_ctrl(table->old_ctrl, table->old_capacity, (size_t)(slot - table->old_slots), CTRL_DELETED);
+    if (slot) {
+        item = ini_store_at(table->store, slot->index);
+        table->size--;
+    }
+    return item;
+}
+
+void* ini_table_next(const ini_table* table, size_t* cursor) {
+    for (size_t index; (index = *cursor) < table->capacity + table->old_capacity; ) {
+        (*cursor)++;
+        if (index < table->capacity) {
+            if (!(table->ctrl[index] & 0x80U))
+                return ini_store_at(table->store, table->slots[index].index);
+        }
+        else if (!(table->old_ctrl[index - table->capacity] & 0x80U))
+            return ini_store_at(table->store, table->old_slots[index - table->capacity].index);
+    }
+    return NULL;
+}
+
+#pragma endregion
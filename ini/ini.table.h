@@ -0,0 +1,138 @@
+/*******************************************************************************
+ *  @file      ini.table.h
+ *  @brief     Flat open-addressing hash table (swiss table layout)
+ *  @author    Young Sideways
+ *  @date      17.10.2026
+ *  @copyright © Young Sideways, 2026. All right reserved.
+ ******************************************************************************/
+
+#ifndef _INI_TABLE_H_
+#define _INI_TABLE_H_
+
+#pragma once
+
+#pragma region --- INCLUDES ---
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "ini.arena.h"
+#include "ini.store.h"
+
+#pragma endregion
+
+#pragma region --- MACROS ---
+
+#define HT_INIT_SIZE         8U
+#define HT_SIZE_GROWTH(size) (((size) < 8U) ? 8U : ((size) << 1)) // x2 factor
+#define HT_MAX_LOAD_FACTOR   0.75f // 75%
+
+#define INI_TABLE_GROUP_WIDTH 16U //!< control bytes probed at once (one SSE2 register)
+
+#pragma endregion
+
+#pragma region --- TYPEDEFS ---
+
+typedef uint32_t                ini_table_hash;
+typedef struct ini_table_slot   ini_table_slot;
+typedef struct ini_table        ini_table;
+
+/**
+ *  @brief  compares table item with a lookup key
+ *  @param  item - stored item
+ *  @param  key  - key passed to ini_table_find
+ *  @retval      - true if item has the key
+ */
+typedef bool (*ini_table_match)(const void* item, const void* key);
+
+#pragma endregion
+
+#pragma region --- STRUCTS ---
+
+struct ini_table_slot {
+    ini_table_hash hash;   //!< full item hash, compared before the item is touched
+    ini_store_index index; //!< item index in the store of the table
+};
+
+/**
+ *  @brief open addressing table with a control byte per slot
+ *  @note  control byte keeps 7 high bits of hash of a full slot, so a whole
+ *         group of 16 slots is filtered by a single SIMD compare.
+ *         On growth items move to the new table a group per insertion,
+ *         lookups check both tables until the old one is drained.
+ *         Items live in a store, slots keep their 32 bit indices only.
+ */
+struct ini_table {
+    const ini_store* store;      //!< items
+    uint8_t* ctrl;               //!< capacity + INI_TABLE_GROUP_WIDTH control bytes (tail mirrors the head)
+    ini_table_slot* slots;       //!< capacity slots
+    size_t capacity;             //!< power of two, 0 - nothing allocated
+    size_t used;                 //!< full and deleted slots of the current table
+    size_t size;                 //!< count of items in both tables
+
+    uint8_t* old_ctrl;           //!< table being drained (NULL - no resize in progress)
+    ini_table_slot* old_slots;   //!< slots of the table being drained
+    size_t old_capacity;         //!< capacity of the table being drained
+    size_t migrated;             //!< count of old slots already drained
+};
+
+#pragma endregion
+
+#pragma region --- FUNCTIONS ---
+
+/**
+ *  @brief initializes empty table, no memory is allocated
+ *  @param table - table
+ *  @param store - store of the items, must outlive the table
+ */
+void ini_table_init(ini_table* table, const ini_store* store);
+
+/**
+ *  @brief  finds item
+ *  @param  table - table
+ *  @param  hash  - key hash
+ *  @param  match - key comparator, called only for items with the same hash
+ *  @param  key   - key
+ *  @retval       - item, or NULL if not found
+ */
+void* ini_table_find(const ini_table* table, ini_table_hash hash, ini_table_match match, const void* key);
+
+/**
+ *  @brief requests control bytes and slots of the first group of the key, see ini_table_find
+ *  @param table - table
+ *  @param hash  - key hash
+ */
+void ini_table_prefetch(const ini_table* table, ini_table_hash hash);
+
+/**
+ *  @brief  inserts item without checking for duplicates
+ *  @param  table - table
+ *  @param  arena - memory for table growth
+ *  @param  hash  - item hash
+ *  @param  index - item index in the store
+ *  @retval       - false on allocation fail
+ */
+bool ini_table_insert(ini_table* table, ini_arena* arena, ini_table_hash hash, ini_store_index index);
+
+/**
+ *  @brief  removes item, its slot is reused by later insertions
+ *  @param  table - table
+ *  @param  hash  - key hash
+ *  @param  match - key comparator, called only for items with the same hash
+ *  @param  key   - key
+ *  @retval       - removed item, or NULL if not found
+ */
+void* ini_table_remove(ini_table* table, ini_table_hash hash, ini_table_match match, const void* key);
+
+/**
+ *  @brief  iterates items in slot order
+ *  @param  table  - table, must not be modified during iteration
+ *  @param  cursor - iteration state, 0 before the first call
+ *  @retval        - next item, or NULL at the end
+ */
+void* ini_table_next(const ini_table* table, size_t* cursor);
+
+#pragma endregion
+
+#endif // !_INI_TABLE_H_
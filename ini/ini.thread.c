@@ -0,0 +1,83 @@
+/*******************************************************************************
+ *  @file      ini.thread.c
+ *  @brief     Minimal portable threads for the parallel loader
+ *  @author    Young Sideways
+ *  @date      17.10.2026
+ *  @copyright © Young Sideways, 2026. All right reserved.
+ ******************************************************************************/
+
+#include "ini.thread.h"
+
+#pragma region --- INCLUDES ---
+
+#ifdef _WIN32
+#   define WIN32_LEAN_AND_MEAN
+#   include <windows.h>
+#else
+#   include <pthread.h>
+#   include <unistd.h>
+#endif
+
+#pragma endregion
+
+#pragma region --- FUNCTIONS ---
+
+#ifdef _WIN32
+
+static DWORD WINAPI _thread_entry(LPVOID arg) {
+    ini_thread* thread = arg;
+    thread->routine(thread->arg);
+    return 0;
+}
+
+bool ini_thread_start(ini_thread* thread, ini_thread_routine routine, void* arg) {
+    thread->routine = routine;
+    thread->arg     = arg;
+    HANDLE handle = CreateThread(NULL, 0, _thread_entry, thread, 0, NULL);
+    thread->handle = (intptr_t)handle;
+    return handle != NULL;
+}
+
+void ini_thread_join(ini_thread* thread) {
+    WaitForSingleObject((HANDLE)thread->handle, INFINITE);
+    CloseHandle((HANDLE)thread->handle);
+    thread->handle = 0;
+}
+
+unsigned ini_thread_concurrency(void) {
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return info.dwNumberOfProcessors ? (unsigned)info.dwNumberOfProcessors : 1U;
+}
+
+#else
+
+static void* _thread_entry(void* arg) {
+    ini_thread* thread = arg;
+    thread->routine(thread->arg);
+    return NULL;
+}
+
+bool ini_thread_start(ini_thread* thread, ini_thread_routine routine, void* arg) {
+    thread->routine = routine;
+    thread->arg     = arg;
+    pthread_t handle;
+    if (pthread_create(&handle, NULL, _thread_entry, thread) != 0)
+        return false;
+    thread->handle = (intptr_t)handle;
+    return true;
+}
+
+void ini_thread_join(ini_thread* thread) {
+    pthread_join((pthread_t)thread->handle, NULL);
+    thread->handle = 0;
+}
+
+unsigned ini_thread_concurrency(void) {
+    long count = sysconf(_SC_NPROCESSORS_ONLN);
+    return count > 0 ? (unsigned)count : 1U;
+}
+
+#endif
+
+#pragma endregion
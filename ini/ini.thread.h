@@ -0,0 +1,63 @@
+/*******************************************************************************
+ *  @file      ini.thread.h
+ *  @brief     Minimal portable threads for the parallel loader
+ *  @author    Young Sideways
+ *  @date      17.10.2026
+ *  @copyright © Young Sideways, 2026. All right reserved.
+ ******************************************************************************/
+
+#ifndef _INI_THREAD_H_
+#define _INI_THREAD_H_
+
+#pragma once
+
+#pragma region --- INCLUDES ---
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#pragma endregion
+
+#pragma region --- TYPEDEFS ---
+
+typedef struct ini_thread ini_thread;
+
+typedef void (*ini_thread_routine)(void* arg);
+
+#pragma endregion
+
+#pragma region --- STRUCTS ---
+
+struct ini_thread {
+    intptr_t handle;            //!< platform thread handle
+    ini_thread_routine routine; //!< thread body
+    void* arg;                  //!< body argument
+};
+
+#pragma endregion
+
+#pragma region --- FUNCTIONS ---
+
+/**
+ *  @brief  starts thread
+ *  @param  thread  - thread, must stay alive until ini_thread_join
+ *  @param  routine - thread body
+ *  @param  arg     - body argument
+ *  @retval         - false if thread can't be started
+ */
+bool ini_thread_start(ini_thread* thread, ini_thread_routine routine, void* arg);
+
+/**
+ *  @brief waits for thread end
+ *  @param thread - started thread
+ */
+void ini_thread_join(ini_thread* thread);
+
+/**
+ *  @brief  count of logical processors (at least 1)
+ */
+unsigned ini_thread_concurrency(void);
+
+#pragma endregion
+
+#endif // !_INI_THREAD_H_
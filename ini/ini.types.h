@@ -14,11 +14,21 @@
 #pragma region --- INCLUDES ---
 
 #include <stdio.h>
+#include <stddef.h>
 #include <string.h>
+#include <limits.h>
+#include <math.h>
 #include <stdint.h>
+#include <inttypes.h>
 #include <stdbool.h>
 
 #include "ini.utils.h"
+#include "ini.arena.h"
+#include "ini.number.h"
+#include "ini.store.h"
+#include "ini.table.h"
+#include "ini.phash.h"
+#include "ini.mapping.h"
 
 #pragma endregion
 
@@ -31,20 +41,43 @@
 
 #define UNUSED(var) ((void)var)
 
+#define INI_PACKED_INLINE 13U //!< longest string kept inside ini_packed (with its terminator)
+
 #pragma endregion
 
 #pragma region --- TYPEDEFS ---
 
 typedef uint32_t            ini_hash;
+typedef uint32_t            ini_key_handle; //!< interned string of a file, 0 - invalid handle
 
 typedef enum ini_value_type ini_value_type;
+typedef enum ini_parse_error_type ini_parse_error_type;
+typedef enum ini_change_type ini_change_type;
 
-typedef char*               ini_key;
+typedef struct ini_string   ini_string;
+typedef ini_string          ini_key;
 typedef struct ini_value    ini_value;
+typedef struct ini_packed   ini_packed;
+
+typedef struct ini_diagnostic ini_diagnostic;
+typedef struct ini_atom       ini_atom;
+typedef struct ini_binding    ini_binding;
+typedef struct ini_region     ini_region;
+typedef struct ini_change     ini_change;
+typedef struct ini_query      ini_query;
 
 typedef struct ini_property ini_property;
 typedef struct ini_section  ini_section;
+typedef struct ini_section_list ini_section_list;
+typedef struct ini_entry_list   ini_entry_list;
+typedef struct ini_frozen       ini_frozen;
 typedef struct ini          INI;
+typedef struct ini_watcher  ini_watcher;
+typedef struct ini_shared   ini_shared;
+typedef struct ini_epoch_reader ini_reader;
+
+typedef bool (*ini_sink)(const char* data, size_t size, void* user); //!< text output of ini_write, false - stop writing
+typedef void (*ini_change_callback)(const ini_change* change, void* user); //!< change applied by ini_reload
 
 #pragma endregion
 
@@ -55,69 +88,349 @@ enum ini_value_type {
 
     INI_INT    = 0x1U,
     INI_DOUBLE = 0x2U,
-    INI_STRING = 0x3U
+    INI_STRING = 0x3U,
+    INI_INT64  = 0x4U, // integer outside of int range
+    INI_RAW    = 0x5U, // not typed yet (lazy file), vstring is the value text
+    INI_BOOL   = 0x6U  // set by ini_set_bool, the parser keeps "true"/"yes" texts as strings
+};
+
+enum ini_parse_error_type {
+    EINI_NO,      // no errors
+    EINI_NPAC,    // null pointer access
+    EINI_MEMF,    // memory allocation fail
+    EINI_OCF,     // open/create fail
+    EINI_INVALTK, // invalid token
+    EINI_LDTRSH,  // string leading trash
+    EINI_TLTRSH,  // string tailing trash
+    EINI_INSEC,   // invalid section name
+    EINI_TOODP,   // subsection too deep
+    EINI_UNBRCK,  // unclosed section bracket
+    EINI_TOOLNG,  // line does not fit the stream window
+    EINI_RANGE    // number value out of range
+};
+
+enum ini_change_type {
+    INI_CHANGE_ADDED,    // new section or property
+    INI_CHANGE_MODIFIED, // property has another value
+    INI_CHANGE_REMOVED   // section or property is removed
 };
 
 #pragma endregion
 
 #pragma region --- STRUCTS ---
 
+/**
+ *  @brief string view
+ *  @note  not null-terminated, when it points into a mapped file
+ */
+struct ini_string {
+    const char* data; //!< first character
+    size_t length;    //!< count of characters
+};
+
 struct ini_value {
     ini_value_type type;
     union {
-        int    vint;
-        double vdouble;
-        char*  vstring;
+        int        vint;
+        int64_t    vint64;
+        double     vdouble;
+        bool       vbool;
+        ini_string vstring;
     };
 };
 
+/**
+ *  @brief  value as a property keeps it, 16 bytes
+ *  @note   a string up to INI_PACKED_INLINE characters is kept inside from the byte 2 on,
+ *          over the fields below the size, a longer one is a pointer with a 32 bit length.
+ *          See ini_value_unpack
+ */
+struct ini_packed {
+    uint8_t type;      //!< ini_value_type
+    uint8_t size;      //!< length + 1 of an inline string, 0 - not an inline string
+    uint8_t storage;   //!< owned string: the buffer has at least (1 << storage) bytes, 0 - a view
+    uint8_t reserved;
+    uint32_t length;   //!< length of a string outside
+    union {
+        int         vint;
+        int64_t     vint64;
+        double      vdouble;
+        bool        vbool;
+        const char* data; //!< string outside
+    };
+};
+
+/**
+ *  @brief parse error
+ */
+struct ini_diagnostic {
+    ini_parse_error_type type; //!< error code
+    int row;                   //!< row of the error (1 - first one), -1 - not bound to the text
+    int column;                //!< column of the error (1 - first one), -1 - not bound to the text
+};
+
+/**
+ *  @brief interned string, the pool keeps a single atom per distinct string
+ */
+struct ini_atom {
+    ini_string string;     //!< null-terminated copy, or view into mapping
+    ini_hash hash;         //!< string hash, computed once
+    ini_key_handle handle; //!< index in the pool + 1
+    ini_section* section;  //!< section with this dotted name, resolved by ini_intern
+};
+
+/**
+ *  @brief property value converted to every bound type at once, see ini_bind_int
+ */
+struct ini_binding {
+    int vint;            //!< as ini_to_int
+    int64_t vint64;      //!< as ini_to_int64
+    double vdouble;      //!< as ini_to_double
+    bool vbool;          //!< as ini_to_bool
+    const char* vstring; //!< null-terminated text of the value (in the arena)
+    size_t capacity;     //!< longest text vstring holds, it is overwritten in place up to it
+};
+
+/**
+ *  @brief fingerprint of a top level declaration with the text up to the next one
+ */
+struct ini_region {
+    ini_section* section; //!< declared section ("root" for the text before the first declaration)
+    uint64_t hash;        //!< hash of the text
+};
+
+/**
+ *  @brief change of the file, see ini_reload
+ */
+struct ini_change {
+    ini_change_type type; //!< kind of the change
+    const char* section;  //!< full dotted section name, valid during the callback
+    const char* key;      //!< property key, valid during the callback, NULL - the section itself
+    ini_value value;      //!< new value, INI_NONE for a removed property
+};
+
+/**
+ *  @brief property lookup of ini_get_values
+ */
+struct ini_query {
+    const char* section; //!< dotted section name, NULL - root section
+    const char* key;     //!< property key
+};
+
 struct ini_property {
-    ini_section* section; //!< parent object
+    ini_section* section;  //!< parent object
+
+    ini_hash hash;         //!< key hash
+    ini_key_handle handle; //!< interned key
+    ini_key key;           //!< property key (string of the atom)
+    ini_packed value;      //!< property value, see ini_value_unpack
+    ini_binding* binding;  //!< converted value, created by the first ini_bind_* call
+    bool removed;          //!< removed by ini_property_remove (or not bound yet), walks skip it
+};
+
+/**
+ *  @brief  subsections of a node of the section tree
+ *  @note   sections are appended as they are declared, the list is sorted by name
+ *          (case insensitive) on the first query after that
+ */
+struct ini_section_list {
+    ini_section** items; //!< sections (in the arena)
+    size_t count;        //!< count of sections
+    size_t capacity;     //!< allocated items
+    bool sorted;         //!< items are in name order
+};
 
-    ini_property* next;   //!< next property, if it has hash-collision
-    ini_hash hash;        //!< key hash
-    ini_key key;          //!< property key
-    ini_value value;      //!< property value
+/**
+ *  @brief  indices of the entries of a store in declaration order
+ *  @note   removed entries stay in the list until they are the half of it
+ */
+struct ini_entry_list {
+    ini_store_index* items; //!< indices (in the arena)
+    size_t count;           //!< count of indices
+    size_t capacity;        //!< allocated items
+    size_t removed;         //!< count of indices of removed entries
+};
+
+/**
+ *  @brief  lookup tables of ini_freeze, a single probe per name
+ *  @note   slots keep store indices of the entries, an entry is compared with
+ *          the name, as a name out of the file gets some slot too
+ */
+struct ini_frozen {
+    ini_phash sections;              //!< full section names
+    ini_store_index* section_slots;  //!< section of every slot
+    ini_phash properties;            //!< full section names paired with keys
+    ini_store_index* property_slots; //!< property of every slot
 };
 
 struct ini_section {
     INI* file;                 //!< parent object
-    ini_hash hash;             //!< section name hash
-    char* name;                //!< section name
+    ini_section* parent;       //!< enclosing section (NULL for depth 0)
+    ini_hash hash;             //!< full (dotted, lowercase) section name hash
+    ini_string name;           //!< section name without parent prefix (string of the atom)
     uint8_t depth;             //!< subsection depth (0 - section, > 0 - subsections)
+    ini_section_list children; //!< direct subsections
+    bool removed;              //!< removed by ini_remove_section (or not bound yet), cached pointers look it up again
 
-    size_t size;               //!< current count of properties
-    size_t capacity;           //!< current allocated blocks for properties
-    ini_property** properties; //!< properties table pointer
+    ini_table properties;      //!< indices of properties by key
+    ini_entry_list entries;    //!< properties in declaration order
 };
 
 struct ini {
-    const char* path;       //!< path to the file
-
-    ini_section** sections; //!< sections list
-    size_t size;            //!< count of sections
-    size_t capacity;        //!< count of sections
+    ini_arena arena;        //!< owns sections, properties, tables and copied tokens
+    const char* path;       //!< path to the file, copied to the arena for ini_reload and watchers
+    ini_mapping mapping;    //!< file mapping, if opened by ini_open_mapped
+    bool mapped;            //!< keys, names and strings are views into mapping
+    bool lazy;              //!< values are kept as INI_RAW and typed on first access
+    const void* snapshot;   //!< ini_snapshot_header in mapping, if opened by ini_load_snapshot (only the empty root section)
+    ini_binding** snapshot_bindings; //!< bindings of snapshot properties by record, created by the first ini_bind_*
+
+    ini_store section_store;  //!< sections in declaration order, removed ones included
+    ini_store property_store; //!< properties in declaration order, removed ones included
+    ini_table sections;       //!< indices of sections by full name
+    ini_frozen* frozen;       //!< tables of ini_freeze, NULL - not frozen (dropped by any change of the names)
+    ini_section_list tree;    //!< top level sections, roots of the section tree
+    ini_region* regions;      //!< fingerprints of the text of the last ini_reload, NULL - unknown
+    size_t region_count;      //!< count of regions
+
+    ini_store atom_store;            //!< atoms by handle - 1
+    ini_table atoms;                 //!< indices of interned keys and section names by hash
+
+    ini_diagnostic* diagnostics;     //!< parse errors in file order (in the arena)
+    size_t diagnostic_count;         //!< count of diagnostics
+    size_t diagnostic_capacity;      //!< allocated diagnostics
+    ini_parse_error_type last_error; //!< last parse error, kept even if the list couldn't grow
 };
 
 #pragma endregion
 
 #pragma region --- FUNCIONS ---
 
-ini_value ini_value_default(ini_value_type type) {
+/**
+ *  @brief  copies string value to a null-terminated buffer
+ *  @param  value  - ini string value
+ *  @param  buffer - memory block to put string in it
+ *  @param  size   - size of memory block
+ *  @retval        - false, if string doesn't fit
+ */
+static inline bool _ini_value_to_cstr(_IN const ini_value value, _OUT char* buffer, _IN size_t size) {
+    if (!value.vstring.data || value.vstring.length >= size)
+        return false;
+    memcpy(buffer, value.vstring.data, value.vstring.length);
+    buffer[value.vstring.length] = '\0';
+    return true;
+}
+
+/**
+ *  @brief  text of an inline string of the packed value
+ */
+static inline char* _ini_packed_text(const ini_packed* packed) {
+    return (char*)packed + offsetof(ini_packed, storage);
+}
+
+/**
+ *  @brief  value of the packed one
+ *  @param  packed - packed value
+ *  @retval        - value, an inline string is a view into the packed value
+ */
+static inline ini_value ini_value_unpack(const ini_packed* packed) {
+    ini_value value = { .type = (ini_value_type)packed->type };
+    switch (value.type)
+    {
+    case INI_INT:
+        value.vint = packed->vint;
+        break;
+    case INI_INT64:
+        value.vint64 = packed->vint64;
+        break;
+    case INI_DOUBLE:
+        value.vdouble = packed->vdouble;
+        break;
+    case INI_BOOL:
+        value.vbool = packed->vbool;
+        break;
+    case INI_STRING:
+    case INI_RAW:
+        value.vstring = packed->size ? (ini_string){ _ini_packed_text(packed), packed->size - 1U }
+                                     : (ini_string){ packed->data, packed->length };
+        break;
+    default:
+        value.vdouble = 0.0;
+        break;
+    }
+    return value;
+}
+
+static inline ini_value ini_value_default(ini_value_type type) {
     switch (type)
     {
     case INI_INT:
         return (ini_value) { .type = type, .vint = 0 };
+    case INI_INT64:
+        return (ini_value) { .type = type, .vint64 = 0 };
     case INI_DOUBLE:
         return (ini_value) { .type = type, .vdouble = 0.0 };
+    case INI_BOOL:
+        return (ini_value) { .type = type, .vbool = false };
     case INI_STRING:
-        return (ini_value) { .type = type, .vstring = NULL };
+        return (ini_value) { .type = type, .vstring = { NULL, 0U } };
     default:
         return (ini_value) { .type = INI_NONE, .vdouble = 0.0 };
     }
 }
 
-bool ini_to_bool(_IN const ini_value value) {
+/**
+ *  @brief  number of a string value, the literals are the ones the parser types
+ *  @retval - INI_INT64 value (saturated on overflow), INI_DOUBLE value, or INI_NONE value if it isn't a number
+ */
+static inline ini_value _ini_string_number(_IN const ini_value value) {
+    const char* data = value.vstring.data;
+    size_t size = value.vstring.length;
+    if (!data)
+        return ini_value_default(INI_NONE);
+
+    bool negative = size && data[0] == '-';
+    int64_t vint64;
+    switch (ini_parse_int(data, size, &vint64))
+    {
+    case INI_NUMBER_OK:
+        return (ini_value){ .type = INI_INT64, .vint64 = vint64 };
+    case INI_NUMBER_RANGE:
+        return (ini_value){ .type = INI_INT64, .vint64 = negative ? INT64_MIN : INT64_MAX };
+    default:
+        break;
+    }
+
+    double vdouble;
+    switch (ini_parse_double(data, size, &vdouble))
+    {
+    case INI_NUMBER_OK:
+        return (ini_value){ .type = INI_DOUBLE, .vdouble = vdouble };
+    case INI_NUMBER_RANGE:
+        return (ini_value){ .type = INI_DOUBLE, .vdouble = negative ? -HUGE_VAL : HUGE_VAL };
+    default:
+        return ini_value_default(INI_NONE);
+    }
+}
+
+/**
+ *  @brief  double saturated to int64_t range, NaN is 0
+ */
+static inline int64_t _ini_double_to_int64(double value) {
+    if (value != value)
+        return 0;
+    if (value <= (double)INT64_MIN)
+        return INT64_MIN;
+    if (value >= (double)INT64_MAX)
+        return INT64_MAX;
+    return (int64_t)value;
+}
+
+static inline int _ini_int64_to_int(int64_t value) {
+    return (value < INT_MIN) ? INT_MIN : (value > INT_MAX) ? INT_MAX : (int)value;
+}
+
+static inline bool ini_to_bool(_IN const ini_value value) {
 
     static const char* _true_alias[]  = { "true", "yes", "y" };
 
@@ -125,16 +438,17 @@ bool ini_to_bool(_IN const ini_value value) {
     {
     case INI_INT:
         return !!value.vint;
+    case INI_INT64:
+        return !!value.vint64;
     case INI_DOUBLE:
         return !!value.vdouble;
-    case INI_STRING: {
-        if (!value.vstring)
-            return false;
-        size_t size = strlen(value.vstring);
-        if (size > 4)
-            return false;
+    case INI_BOOL:
+        return value.vbool;
+    case INI_STRING:
+    case INI_RAW: {
         char buf[5];
-        strncpy(buf, value.vstring, 5);
+        if (!_ini_value_to_cstr(value, buf, sizeof(buf)))
+            return false;
         str_lower(buf);
         return strcmp(buf, "true") == 0 || strcmp(buf, "yes") == 0 || strcmp(buf, "y") == 0;
     }
@@ -143,33 +457,70 @@ bool ini_to_bool(_IN const ini_value value) {
     }
 }
 
-int ini_to_int(_IN const ini_value value) {
+/**
+ *  @note INI_INT64 and INI_DOUBLE values are saturated to int range
+ */
+static inline int ini_to_int(_IN const ini_value value) {
     switch (value.type)
     {
     case INI_INT:
         return value.vint;
+    case INI_INT64:
+        return _ini_int64_to_int(value.vint64);
     case INI_DOUBLE:
-        return (int)value.vdouble;
+        return _ini_int64_to_int(_ini_double_to_int64(value.vdouble));
+    case INI_BOOL:
+        return (int)value.vbool;
     case INI_STRING:
-        if (!value.vstring)
-            return 0;
-        return (int)strtol(value.vstring, NULL, 0); //!< autodetect base;
+    case INI_RAW: {
+        ini_value number = _ini_string_number(value);
+        return (number.type != INI_NONE) ? ini_to_int(number) : 0;
+    }
     default:
         return 0;
     }
 }
 
-double ini_to_double(_IN const ini_value value) {
+/**
+ *  @note INI_DOUBLE values are saturated to int64_t range
+ */
+static inline int64_t ini_to_int64(_IN const ini_value value) {
+    switch (value.type)
+    {
+    case INI_INT:
+        return value.vint;
+    case INI_INT64:
+        return value.vint64;
+    case INI_DOUBLE:
+        return _ini_double_to_int64(value.vdouble);
+    case INI_BOOL:
+        return (int64_t)value.vbool;
+    case INI_STRING:
+    case INI_RAW: {
+        ini_value number = _ini_string_number(value);
+        return (number.type != INI_NONE) ? ini_to_int64(number) : 0;
+    }
+    default:
+        return 0;
+    }
+}
+
+static inline double ini_to_double(_IN const ini_value value) {
     switch (value.type)
     {
     case INI_INT:
         return (double)value.vint;
+    case INI_INT64:
+        return (double)value.vint64;
     case INI_DOUBLE:
         return value.vdouble;
+    case INI_BOOL:
+        return value.vbool ? 1.0 : 0.0;
     case INI_STRING:
-        if (!value.vstring)
-            return 0;
-        return strtod(value.vstring, NULL);
+    case INI_RAW: {
+        ini_value number = _ini_string_number(value);
+        return (number.type != INI_NONE) ? ini_to_double(number) : 0.0;
+    }
     default:
         return 0.0;
     }
@@ -181,7 +532,7 @@ double ini_to_double(_IN const ini_value value) {
  *  @retval       - new null-terminating string with value
  *  @warning allocates memory block for new string
  */
-char* ini_to_str(_IN const ini_value value) {
+static inline char* ini_to_str(_IN const ini_value value) {
     char*  buffer = NULL;
     size_t length = 0;
 
@@ -193,19 +544,34 @@ char* ini_to_str(_IN const ini_value value) {
         if (buffer)
             snprintf(buffer, length + 1, "%d", value.vint);
         break;
-    case INI_DOUBLE:
-        length = (size_t)snprintf(NULL, 0, "%f", value.vdouble); //!< find size of possible string
+    case INI_INT64:
+        length = (size_t)snprintf(NULL, 0, "%" PRId64, value.vint64); //!< find size of possible string
         buffer = (char*)malloc(length + 1);
         if (buffer)
-            snprintf(buffer, length + 1, "%f", value.vdouble);
+            snprintf(buffer, length + 1, "%" PRId64, value.vint64);
+        break;
+    case INI_DOUBLE: {
+        char number[INI_NUMBER_BUFFER_SIZE];
+        length = ini_format_double(value.vdouble, number);
+        buffer = (char*)malloc(length + 1);
+        if (buffer)
+            memcpy(buffer, number, length + 1);
+        break;
+    }
+    case INI_BOOL:
+        length = value.vbool ? 4U : 5U;
+        buffer = (char*)malloc(length + 1);
+        if (buffer)
+            memcpy(buffer, value.vbool ? "true" : "false", length + 1);
         break;
     case INI_STRING:
-        if (!value.vstring)
+    case INI_RAW:
+        if (!value.vstring.data)
             break;
-        length = strlen(value.vstring); //!< find size of possible string
+        length = value.vstring.length;
         buffer = (char*)malloc(length + 1);
         if (buffer)
-            memcpy(buffer, value.vstring, length + 1);
+            _ini_value_to_cstr(value, buffer, length + 1);
         break;
     default:
         break;
@@ -220,20 +586,29 @@ char* ini_to_str(_IN const ini_value value) {
  *  @retval        - written buffer
  *  @warning The buffer must have enough memory to fit string, otherwise UB
  */
-char* ini_to_buf(_IN const ini_value value, _INOUT char* buffer) {
+static inline char* ini_to_buf(_IN const ini_value value, _INOUT char* buffer) {
     if (buffer)
         switch (value.type)
         {
-        case INI_INT: {
-            itoa(value.vint, buffer, 10);
+        case INI_INT:
+        case INI_INT64: {
+            char number[INI_NUMBER_BUFFER_SIZE];
+            size_t length = ini_format_int(ini_to_int64(value), number);
+            memcpy(buffer, number, length + 1);
             break;
         }
         case INI_DOUBLE: {
-            sprintf(buffer,"%f", value.vdouble);
+            char number[INI_NUMBER_BUFFER_SIZE];
+            size_t length = ini_format_double(value.vdouble, number);
+            memcpy(buffer, number, length + 1);
             break;
         }
+        case INI_BOOL:
+            strcpy(buffer, value.vbool ? "true" : "false");
+            break;
         case INI_STRING:
-            strcpy(buffer, value.vstring);
+        case INI_RAW:
+            _ini_value_to_cstr(value, buffer, value.vstring.length + 1);
             break;
         default:
             buffer[0] = '\0';
@@ -247,29 +622,39 @@ char* ini_to_buf(_IN const ini_value value, _INOUT char* buffer) {
  *  @param  value  - ini value
  *  @param  buffer - memory block to put string in it
  *  @param  size   - size of memory block
- *  @retval        - written buffer
+ *  @retval        - written buffer, the value is truncated to size - 1 characters
  */
-char* ini_to_bufn(_IN const ini_value value, _INOUT char* buffer, _IN size_t size) {
+static inline char* ini_to_bufn(_IN const ini_value value, _INOUT char* buffer, _IN size_t size) {
     if (size == 0U)
         return 0;
-    if (buffer)
+    if (buffer) {
+        char number[INI_NUMBER_BUFFER_SIZE];
+        ini_string text = { "", 0U };
         switch (value.type)
         {
-        case INI_INT: {
-            itoa(value.vint, buffer, 10);
+        case INI_INT:
+        case INI_INT64:
+            text = (ini_string){ number, ini_format_int(ini_to_int64(value), number) };
             break;
-        }
-        case INI_DOUBLE: {
-            sprintf(buffer, "%f", value.vdouble);
+        case INI_DOUBLE:
+            text = (ini_string){ number, ini_format_double(value.vdouble, number) };
+            break;
+        case INI_BOOL:
+            text = value.vbool ? (ini_string){ "true", 4U } : (ini_string){ "false", 5U };
             break;
-        }
         case INI_STRING:
-            strcpy(buffer, value.vstring);
+        case INI_RAW:
+            if (value.vstring.data)
+                text = value.vstring;
             break;
         default:
-            buffer[0] = '\0';
             break;
         }
+        if (text.length >= size)
+            text.length = size - 1;
+        memcpy(buffer, text.data, text.length);
+        buffer[text.length] = '\0';
+    }
     return buffer;
 }
 
@@ -16,6 +16,12 @@
 #include <stdlib.h>
 #include <string.h>
 #include <ctype.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef _MSC_VER
+#   include <intrin.h>
+#endif
 
 #pragma endregion
 
@@ -27,7 +33,74 @@
 
 #pragma region --- FUNCTIONS ---
 
-char* skpled(char* str) {
+/**
+ *  @brief  index of the lowest set bit
+ *  @param  mask - non-zero mask
+ */
+static inline unsigned bit_ctz32(uint32_t mask) {
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanForward(&index, mask);
+    return (unsigned)index;
+#else
+    return (unsigned)__builtin_ctz(mask);
+#endif
+}
+
+/**
+ *  @brief  index of the lowest set bit
+ *  @param  mask - non-zero mask
+ */
+static inline unsigned bit_ctz64(uint64_t mask) {
+#if defined(_MSC_VER) && defined(_M_X64)
+    unsigned long index;
+    _BitScanForward64(&index, mask);
+    return (unsigned)index;
+#elif defined(_MSC_VER)
+    return (uint32_t)mask ? bit_ctz32((uint32_t)mask) : 32U + bit_ctz32((uint32_t)(mask >> 32));
+#else
+    return (unsigned)__builtin_ctzll(mask);
+#endif
+}
+
+/**
+ *  @brief  index of the highest set bit
+ *  @param  mask - non-zero mask
+ */
+static inline unsigned bit_msb32(uint32_t mask) {
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanReverse(&index, mask);
+    return (unsigned)index;
+#else
+    return 31U - (unsigned)__builtin_clz(mask);
+#endif
+}
+
+/**
+ *  @brief requests cache line of the address for a read, never faults
+ */
+static inline void mem_prefetch(const void* address) {
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    _mm_prefetch((const char*)address, _MM_HINT_T0);
+#elif defined(__GNUC__) || defined(__clang__)
+    __builtin_prefetch(address, 0, 3);
+#else
+    (void)address;
+#endif
+}
+
+/**
+ *  @brief compares two spans of the same size, ASCII case insensitive
+ */
+static inline bool mem_iequals(const char* lhs, const char* rhs, size_t size) {
+    for (; size; size--)
+        if (tolower((uint8_t)*(lhs++)) != tolower((uint8_t)*(rhs++)))
+            return false;
+    return true;
+}
+
+static inline char* skpled(char* str) {
     if (str) {
         char* ptr = str;
         while (isspace(*ptr)) ptr++;
@@ -36,7 +109,7 @@ char* skpled(char* str) {
     return str;
 }
 
-char* skptai(char* str) {
+static inline char* skptai(char* str) {
     if (str) {
         char* ptr = str + strlen(str) - 1;
         while (isspace(ptr)) ptr--;
@@ -45,7 +118,7 @@ char* skptai(char* str) {
     return str;
 }
 
-void trim(char* str) {
+static inline void trim(char* str) {
     if (!str)
         return;
 
@@ -66,7 +139,7 @@ void trim(char* str) {
     str[size] = '\0';
 }
 
-void ctrim(char* str, const char* charset) {
+static inline void ctrim(char* str, const char* charset) {
     if (!str || !charset)
         return;
     if (!*str || !*charset)
@@ -82,13 +155,13 @@ void ctrim(char* str, const char* charset) {
     *ptr = '\0';
 }
 
-char* str_lower(char* str) {
+static inline char* str_lower(char* str) {
     if (str)
         for(; *str = (char)tolower(*str); str++);
     return str;
 }
 
-char* str_upper(char* str) {
+static inline char* str_upper(char* str) {
     if (str)
         for (; *str = (char)toupper(*str); str++);
 }
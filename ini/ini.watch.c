@@ -0,0 +1,206 @@
+/*******************************************************************************
+ *  @file      ini.watch.c
+ *  @brief     File change notifications for the hot reload
+ *  @author    Young Sideways
+ *  @date      17.10.2026
+ *  @copyright © Young Sideways, 2026. All right reserved.
+ ******************************************************************************/
+
+#include "ini.watch.h"
+
+#pragma region --- INCLUDES ---
+
+#include <string.h>
+
+#ifdef _WIN32
+#   define WIN32_LEAN_AND_MEAN
+#   include <windows.h>
+#elif defined(__linux__)
+#   include <errno.h>
+#   include <poll.h>
+#   include <unistd.h>
+#   include <sys/inotify.h>
+#else
+#   include <time.h>
+#   include <sys/stat.h>
+#endif
+
+#pragma endregion
+
+#pragma region --- MACROS ---
+
+#define INI_WATCH_CLOSED ((intptr_t)-1) //!< handle of a watch that isn't opened
+
+#pragma endregion
+
+#pragma region --- INTERNAL ---
+
+/**
+ *  @brief  copies directory of the file
+ *  @retval - false if the path doesn't fit the buffer
+ */
+static bool _directory(const char* path, char* buffer, const char** name) {
+    const char* slash = strrchr(path, '/');
+#ifdef _WIN32
+    const char* backslash = strrchr(path, '\\');
+    if (backslash && (!slash || backslash > slash))
+        slash = backslash;
+#endif
+    if (!slash) {
+        memcpy(buffer, ".", sizeof("."));
+        *name = path;
+        return true;
+    }
+
+    // "/ini" is in the root directory
+    size_t size = (slash == path) ? 1U : (size_t)(slash - path);
+    if (size >= INI_WATCH_PATH_SIZE)
+        return false;
+    memcpy(buffer, path, size);
+    buffer[size] = '\0';
+    *name = slash + 1;
+    return true;
+}
+
+#pragma endregion
+
+#pragma region --- FUNCTIONS ---
+
+#ifdef _WIN32
+
+static uint64_t _stamp(const char* path) {
+    WIN32_FILE_ATTRIBUTE_DATA data;
+    if (!GetFileAttributesExA(path, GetFileExInfoStandard, &data))
+        return 0U;
+    uint64_t time = ((uint64_t)data.ftLastWriteTime.dwHighDateTime << 32) | data.ftLastWriteTime.dwLowDateTime;
+    uint64_t size = ((uint64_t)data.nFileSizeHigh << 32) | data.nFileSizeLow;
+    return time ^ (size * 0x9E3779B97F4A7C15ULL);
+}
+
+bool ini_watch_open(ini_watch* watch, const char* path) {
+    char directory[INI_WATCH_PATH_SIZE];
+    watch->path   = path;
+    watch->handle = INI_WATCH_CLOSED;
+    if (!_directory(path, directory, &watch->name))
+        return false;
+
+    HANDLE handle = FindFirstChangeNotificationA(directory, FALSE,
+        FILE_NOTIFY_CHANGE_FILE_NAME | FILE_NOTIFY_CHANGE_SIZE | FILE_NOTIFY_CHANGE_LAST_WRITE);
+    if (handle == INVALID_HANDLE_VALUE)
+        return false;
+    watch->handle = (intptr_t)handle;
+    watch->stamp  = _stamp(path);
+    return true;
+}
+
+int ini_watch_wait(ini_watch* watch, int timeout) {
+    DWORD result = WaitForSingleObject((HANDLE)watch->handle, (timeout < 0) ? INFINITE : (DWORD)timeout);
+    if (result == WAIT_TIMEOUT)
+        return 0;
+    if (result != WAIT_OBJECT_0 || !FindNextChangeNotification((HANDLE)watch->handle))
+        return -1;
+
+    // notifications name no files, other files of the directory are told apart by the stamp
+    uint64_t stamp = _stamp(watch->path);
+    if (stamp == watch->stamp)
+        return 0;
+    watch->stamp = stamp;
+    return 1;
+}
+
+void ini_watch_close(ini_watch* watch) {
+    if (watch->handle != INI_WATCH_CLOSED)
+        FindCloseChangeNotification((HANDLE)watch->handle);
+    watch->handle = INI_WATCH_CLOSED;
+}
+
+#elif defined(__linux__)
+
+bool ini_watch_open(ini_watch* watch, const char* path) {
+    char directory[INI_WATCH_PATH_SIZE];
+    watch->path   = path;
+    watch->handle = INI_WATCH_CLOSED;
+    watch->stamp  = 0U;
+    if (!_directory(path, directory, &watch->name))
+        return false;
+
+    int handle = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (handle < 0)
+        return false;
+    if (inotify_add_watch(handle, directory, IN_CLOSE_WRITE | IN_MOVED_TO) < 0) {
+        close(handle);
+        return false;
+    }
+    watch->handle = (intptr_t)handle;
+    return true;
+}
+
+int ini_watch_wait(ini_watch* watch, int timeout) {
+    struct pollfd request = { .fd = (int)watch->handle, .events = POLLIN, .revents = 0 };
+    int ready = poll(&request, 1, timeout);
+    if (ready <= 0)
+        return (ready < 0 && errno != EINTR) ? -1 : 0;
+
+    union {
+        struct inotify_event event;
+        char data[16U * (sizeof(struct inotify_event) + 256U)];
+    } buffer;
+    bool changed = false;
+    for (ssize_t size; (size = read((int)watch->handle, buffer.data, sizeof(buffer.data))) > 0; )
+        for (const char* item = buffer.data; item < buffer.data + size; ) {
+            const struct inotify_event* event = (const struct inotify_event*)item;
+            if (event->len && strcmp(event->name, watch->name) == 0)
+                changed = true;
+            item += sizeof(struct inotify_event) + event->len;
+        }
+    return changed ? 1 : 0;
+}
+
+void ini_watch_close(ini_watch* watch) {
+    if (watch->handle != INI_WATCH_CLOSED)
+        close((int)watch->handle);
+    watch->handle = INI_WATCH_CLOSED;
+}
+
+#else
+
+static uint64_t _stamp(const char* path) {
+    struct stat info;
+    if (stat(path, &info) != 0)
+        return 0U;
+    return (uint64_t)info.st_mtime ^ ((uint64_t)info.st_size * 0x9E3779B97F4A7C15ULL);
+}
+
+bool ini_watch_open(ini_watch* watch, const char* path) {
+    char directory[INI_WATCH_PATH_SIZE];
+    watch->path   = path;
+    watch->handle = INI_WATCH_CLOSED;
+    if (!_directory(path, directory, &watch->name))
+        return false;
+    watch->handle = 0;
+    watch->stamp  = _stamp(path);
+    return true;
+}
+
+int ini_watch_wait(ini_watch* watch, int timeout) {
+    // no notifications: the stamp is polled until the timeout
+    for (int waited = 0; ; waited += INI_WATCH_POLL_INTERVAL) {
+        uint64_t stamp = _stamp(watch->path);
+        if (stamp != watch->stamp) {
+            watch->stamp = stamp;
+            return 1;
+        }
+        if (timeout >= 0 && waited >= timeout)
+            return 0;
+        struct timespec interval = { .tv_sec = 0, .tv_nsec = INI_WATCH_POLL_INTERVAL * 1000000L };
+        nanosleep(&interval, NULL);
+    }
+}
+
+void ini_watch_close(ini_watch* watch) {
+    watch->handle = INI_WATCH_CLOSED;
+}
+
+#endif
+
+#pragma endregion
@@ -0,0 +1,77 @@
+/*******************************************************************************
+ *  @file      ini.watch.h
+ *  @brief     File change notifications for the hot reload
+ *  @author    Young Sideways
+ *  @date      17.10.2026
+ *  @copyright © Young Sideways, 2026. All right reserved.
+ ******************************************************************************/
+
+#ifndef _INI_WATCH_H_
+#define _INI_WATCH_H_
+
+#pragma once
+
+#pragma region --- INCLUDES ---
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#pragma endregion
+
+#pragma region --- MACROS ---
+
+#define INI_WATCH_PATH_SIZE     4096 //!< max length of the watched directory path
+#define INI_WATCH_POLL_INTERVAL 100  //!< ms between checks of the fallback without notifications
+
+#pragma endregion
+
+#pragma region --- TYPEDEFS ---
+
+typedef struct ini_watch ini_watch;
+
+#pragma endregion
+
+#pragma region --- STRUCTS ---
+
+/**
+ *  @brief watch of a single file
+ *  @note  the directory is watched, so the file may be replaced by rename, as editors save it
+ */
+struct ini_watch {
+    const char* path; //!< watched file
+    const char* name; //!< file name in the path
+    intptr_t handle;  //!< platform notification handle (-1 - not opened)
+    uint64_t stamp;   //!< modification time and size of the last check (platforms without file names in events)
+};
+
+#pragma endregion
+
+#pragma region --- FUNCTIONS ---
+
+/**
+ *  @brief  starts watching file
+ *  @param  watch - watch to fill
+ *  @param  path  - path to the file, must outlive the watch
+ *  @retval       - false if the directory of the file can't be watched
+ */
+bool ini_watch_open(ini_watch* watch, const char* path);
+
+/**
+ *  @brief  waits for a change of the file
+ *  @param  watch   - opened watch
+ *  @param  timeout - max wait in ms, 0 - just check, < 0 - no limit
+ *  @retval         - 1 if the file is changed, 0 on timeout, -1 on error
+ *  @note   pending notifications are read out at once, a save firing several events is a single change
+ */
+int ini_watch_wait(ini_watch* watch, int timeout);
+
+/**
+ *  @brief stops watching
+ *  @param watch - watch opened by ini_watch_open (or failed to open)
+ */
+void ini_watch_close(ini_watch* watch);
+
+#pragma endregion
+
+#endif // !_INI_WATCH_H_
@@ -0,0 +1,195 @@
+/*******************************************************************************
+ *  @file      ini.writer.c
+ *  @brief     Buffered ini text serializer
+ *  @author    Young Sideways
+ *  @date      17.10.2026
+ *  @copyright © Young Sideways, 2026. All right reserved.
+ ******************************************************************************/
+
+#include "ini.writer.h"
+
+#pragma region --- INCLUDES ---
+
+#include <math.h>
+
+#include "ini.lexer.h"
+#include "ini.number.h"
+#include "ini.parser.h"
+
+#pragma endregion
+
+#pragma region --- INTERNAL ---
+
+/**
+ *  @brief output buffer between the serializer and the sink
+ */
+typedef struct ini_text_writer {
+    char* buffer;  //!< INI_WRITE_BUFFER_SIZE bytes
+    size_t filled; //!< bytes waiting for the sink
+    ini_sink sink; //!< output
+    void* user;    //!< sink argument
+    bool failed;   //!< the sink stopped writing
+} ini_text_writer;
+
+static void _flush(ini_text_writer* writer) {
+    if (writer->filled && !writer->failed && !writer->sink(writer->buffer, writer->filled, writer->user))
+        writer->failed = true;
+    writer->filled = 0U;
+}
+
+static void _write(ini_text_writer* writer, const char* data, size_t size) {
+    while (size && !writer->failed) {
+        size_t part = INI_WRITE_BUFFER_SIZE - writer->filled;
+        if (part > size)
+            part = size;
+        memcpy(writer->buffer + writer->filled, data, part);
+        writer->filled += part;
+        data += part;
+        size -= part;
+        if (writer->filled == INI_WRITE_BUFFER_SIZE)
+            _flush(writer);
+    }
+}
+
+static inline void _put(ini_text_writer* writer, char ch) {
+    if (writer->filled == INI_WRITE_BUFFER_SIZE)
+        _flush(writer);
+    writer->buffer[writer->filled++] = ch;
+}
+
+/**
+ *  @brief  characters the lexer takes as structure inside a value
+ */
+static inline bool _is_escaped(char ch) {
+    return ch == '[' || ch == ']' || ch == '#' || ch == ';' || ch == '\\';
+}
+
+/**
+ *  @brief  writes text value, runs of plain characters are copied at once
+ *  @note   a line break can't be escaped, such a value stops the writer
+ */
+static void _write_text(ini_text_writer* writer, const ini_string text) {
+    if (memchr(text.data, '\n', text.length)) {
+        writer->failed = true;
+        return;
+    }
+
+    const char* plain = text.data;
+    const char* end = text.data + text.length;
+    for (const char* str = plain; str < end; str++)
+        if (_is_escaped(*str)) {
+            _write(writer, plain, (size_t)(str - plain));
+            _put(writer, '\\');
+            plain = str;
+        }
+    _write(writer, plain, (size_t)(end - plain));
+}
+
+static void _write_value(ini_text_writer* writer, const ini_value value) {
+    char number[INI_NUMBER_BUFFER_SIZE];
+    switch (value.type)
+    {
+    case INI_INT:
+        _write(writer, number, ini_format_int(value.vint, number));
+        break;
+    case INI_INT64:
+        _write(writer, number, ini_format_int(value.vint64, number));
+        break;
+    case INI_DOUBLE:
+        // "inf" and "nan" are read back as strings
+        if (!isfinite(value.vdouble))
+            writer->failed = true;
+        else
+            _write(writer, number, ini_format_double(value.vdouble, number));
+        break;
+    case INI_BOOL:
+        if (value.vbool)
+            _write(writer, "true", 4U);
+        else
+            _write(writer, "false", 5U);
+        break;
+    case INI_STRING:
+    case INI_RAW:
+        if (value.vstring.data)
+            _write_text(writer, value.vstring);
+        break;
+    default:
+        break;
+    }
+}
+
+static void _write_header(ini_text_writer* writer, const ini_section* section) {
+    _put(writer, '[');
+    for (uint8_t depth = 0U; depth < section->depth; depth++)
+        _put(writer, '.');
+    _write(writer, section->name.data, section->name.length);
+    _write(writer, "]\n", 2U);
+}
+
+static void _write_properties(ini_text_writer* writer, const INI* file, const ini_section* section, bool* empty) {
+    ini_property_walk properties;
+    ini_property_walk_init(&properties, file, section);
+    for (const ini_property* property; (property = ini_property_walk_next(&properties)); ) {
+        if (property->value.type == INI_NONE)
+            continue;
+        _write(writer, property->key.data, property->key.length);
+        _write(writer, " = ", 3U);
+        _write_value(writer, ini_value_unpack(&property->value));
+        _put(writer, '\n');
+        *empty = false;
+    }
+}
+
+#pragma endregion
+
+#pragma region --- FUNCTIONS ---
+
+bool ini_text_write(const INI* file, ini_sink sink, void* user) {
+    if (!file || !sink || file->snapshot)
+        return false;
+
+    const ini_allocator* allocator = &file->arena.allocator;
+    ini_text_writer writer = { .buffer = allocator->alloc(INI_WRITE_BUFFER_SIZE, allocator->user), .filled = 0U, .sink = sink, .user = user, .failed = false };
+    if (!writer.buffer)
+        return false;
+
+    // "root" goes first, its properties are written before any declaration
+    const ini_section* root = ini_find_section(file, "root", sizeof("root") - 1U);
+    bool empty = true;  //!< nothing is written yet
+    if (root)
+        _write_properties(&writer, file, root, &empty);
+
+    // declared sections by depth, as the parser resolves relative subsections
+    ini_section_walk sections;
+    ini_section_walk_init(&sections, file);
+    const ini_section* path[INI_MAX_DEPTH + 1] = { root };
+    uint8_t last = 0U;  //!< depth of the last declaration
+    for (const ini_section* section; !writer.failed && (section = ini_section_walk_next(&sections)); ) {
+        if (section == root)
+            continue;
+
+        const ini_section* chain[INI_MAX_DEPTH + 1];
+        for (const ini_section* part = section; part; part = part->parent)
+            chain[part->depth] = part;
+
+        // parents, that aren't the current sections of their depth, are declared again
+        uint8_t depth = 0U;
+        while (depth < section->depth && depth <= last && path[depth] == chain[depth])
+            depth++;
+        if (!empty)
+            _put(&writer, '\n');
+        for (; depth <= section->depth; depth++) {
+            _write_header(&writer, chain[depth]);
+            path[depth] = chain[depth];
+        }
+        last  = section->depth;
+        empty = false;
+        _write_properties(&writer, file, section, &empty);
+    }
+    _flush(&writer);
+
+    allocator->free(writer.buffer, INI_WRITE_BUFFER_SIZE, allocator->user);
+    return !writer.failed;
+}
+
+#pragma endregion
@@ -0,0 +1,48 @@
+/*******************************************************************************
+ *  @file      ini.writer.h
+ *  @brief     Buffered ini text serializer
+ *  @author    Young Sideways
+ *  @date      17.10.2026
+ *  @copyright © Young Sideways, 2026. All right reserved.
+ ******************************************************************************/
+
+#ifndef _INI_WRITER_H_
+#define _INI_WRITER_H_
+
+#pragma once
+
+#pragma region --- INCLUDES ---
+
+#include "ini.types.h"
+
+#pragma endregion
+
+#pragma region --- MACROS ---
+
+#define INI_WRITE_BUFFER_SIZE (64U << 10) //!< output is passed to the sink by blocks of this size
+
+#pragma endregion
+
+#pragma region --- FUNCTIONS ---
+
+/**
+ *  @brief  serializes sections and properties in declaration order
+ *  @param  file - parsed ini file
+ *  @param  sink - output
+ *  @param  user - sink argument
+ *  @retval      - false on allocation fail, if the sink stopped writing, for a snapshot file,
+ *                 or if a value can't be written: a double that isn't finite, a string with a line break
+ *  @note   subsections are written relative to their parents ("[.com1]"), a parent
+ *          declaration is repeated where the text order needs it. Numbers are parsed back
+ *          to the same type and value, comments aren't kept. The text has no quoting, so
+ *          the rest of the values may change on a read back:
+ *          - strings that are number literals ("42") are read as numbers, "" as INT 0;
+ *          - spaces around a string are trimmed;
+ *          - booleans are read as "true" / "false" strings;
+ *          - properties without a value (INI_NONE) aren't written
+ */
+bool ini_text_write(const INI* file, ini_sink sink, void* user);
+
+#pragma endregion
+
+#endif // !_INI_WRITER_H_